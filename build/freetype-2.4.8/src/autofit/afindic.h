@@ -0,0 +1,40 @@
+/***************************************************************************/
+/*                                                                         */
+/*  afindic.h                                                              */
+/*                                                                         */
+/*    Auto-fitter hinting routines for Indic scripts (specification).      */
+/*                                                                         */
+/*  Copyright 2007 by                                                      */
+/*  Rahul Bhalerao <rahul.bhalerao@redhat.com>, <b.rahul.pm@gmail.com>.    */
+/*                                                                         */
+/*  This file is part of the FreeType project, and may only be used,       */
+/*  modified, and distributed under the terms of the FreeType project      */
+/*  license, LICENSE.TXT.  By continuing to use, modify, or distribute     */
+/*  this file you indicate that you have read the license and              */
+/*  understand and accept it fully.                                        */
+/*                                                                         */
+/***************************************************************************/
+
+
+#ifndef __AFINDIC_H__
+#define __AFINDIC_H__
+
+#include "afhints.h"
+
+
+FT_BEGIN_HEADER
+
+
+  /* the Indic-specific script class */
+
+  AF_DECLARE_SCRIPT_CLASS(af_indic_script_class)
+
+
+/* */
+
+FT_END_HEADER
+
+#endif /* __AFINDIC_H__ */
+
+
+/* END */
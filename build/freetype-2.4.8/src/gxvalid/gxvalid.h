@@ -0,0 +1,107 @@
+/***************************************************************************/
+/*                                                                         */
+/*  gxvalid.h                                                              */
+/*                                                                         */
+/*    TrueTyeeGX/AAT table validation (specification only).                */
+/*                                                                         */
+/*  Copyright 2005 by suzuki toshiya, Masatake YAMATO, Red Hat K.K.,       */
+/*  David Turner, Robert Wilhelm, and Werner Lemberg.                      */
+/*                                                                         */
+/*  This file is part of the FreeType project, and may only be used,       */
+/*  modified, and distributed under the terms of the FreeType project      */
+/*  license, LICENSE.TXT.  By continuing to use, modify, or distribute     */
+/*  this file you indicate that you have read the license and              */
+/*  understand and accept it fully.                                        */
+/*                                                                         */
+/***************************************************************************/
+
+/***************************************************************************/
+/*                                                                         */
+/* gxvalid is derived from both gxlayout module and otvalid module.        */
+/* Development of gxlayout is supported by the Information-technology      */
+/* Promotion Agency(IPA), Japan.                                           */
+/*                                                                         */
+/***************************************************************************/
+
+
+#ifndef __GXVALID_H__
+#define __GXVALID_H__
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "gxverror.h"          /* must come before FT_INTERNAL_VALIDATE_H */
+
+#include FT_INTERNAL_VALIDATE_H
+#include FT_INTERNAL_STREAM_H
+
+
+FT_BEGIN_HEADER
+
+
+  FT_LOCAL( void )
+  gxv_feat_validate( FT_Bytes      table,
+                     FT_Face       face,
+                     FT_Validator  valid );
+
+
+  FT_LOCAL( void )
+  gxv_bsln_validate( FT_Bytes      table,
+                     FT_Face       face,
+                     FT_Validator  valid );
+
+
+  FT_LOCAL( void )
+  gxv_trak_validate( FT_Bytes      table,
+                     FT_Face       face,
+                     FT_Validator  valid );
+
+  FT_LOCAL( void )
+  gxv_just_validate( FT_Bytes      table,
+                     FT_Face       face,
+                     FT_Validator  valid );
+
+  FT_LOCAL( void )
+  gxv_mort_validate( FT_Bytes      table,
+                     FT_Face       face,
+                     FT_Validator  valid );
+
+  FT_LOCAL( void )
+  gxv_morx_validate( FT_Bytes      table,
+                     FT_Face       face,
+                     FT_Validator  valid );
+
+  FT_LOCAL( void )
+  gxv_kern_validate( FT_Bytes      table,
+                     FT_Face       face,
+                     FT_Validator  valid );
+
+  FT_LOCAL( void )
+  gxv_kern_validate_classic( FT_Bytes      table,
+                             FT_Face       face,
+                             FT_Int        dialect_flags,
+                             FT_Validator  valid );
+
+  FT_LOCAL( void )
+  gxv_opbd_validate( FT_Bytes      table,
+                     FT_Face       face,
+                     FT_Validator  valid );
+
+  FT_LOCAL( void )
+  gxv_prop_validate( FT_Bytes      table,
+                     FT_Face       face,
+                     FT_Validator  valid );
+
+  FT_LOCAL( void )
+  gxv_lcar_validate( FT_Bytes      table,
+                     FT_Face       face,
+                     FT_Validator  valid );
+
+
+FT_END_HEADER
+
+
+#endif /* __GXVALID_H__ */
+
+
+/* END */
@@ -0,0 +1,17 @@
+typedef enum foo_enum_e			/* Sample enumeration type */
+{
+  FOO_ONE,				/* One fish */
+  FOO_TWO,				/* Two fish */
+  FOO_RED,				/* Red fish */
+  FOO_BLUE,				/* Blue fish */
+  FOO_PRIVATE				/* Private fish @private@ */
+} foo_enum_t;
+
+typedef enum foo_enum2_e		/* Sample enumeration type #2 */
+{
+  FOO2_ONE,				/* One fish #2 */
+  FOO2_TWO,				/* Two fish #2 */
+  FOO2_RED,				/* Red fish #2 */
+  FOO2_BLUE,				/* Blue fish #2 */
+  FOO2_PRIVATE				/* Private fish #2 @private@ */
+} foo_enum2_t;
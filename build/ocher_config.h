@@ -0,0 +1,6 @@
+/* OCHER_UI_NCURSES */
+#define OCHER_UI_FD 1
+/* OCHER_UI_SDL */
+#define OCHER_TARGET_POSIX
+/* OCHER_UI_MX50 */
+#define OCHER_UI_MEMORY 1
@@ -0,0 +1,28 @@
+#ifndef SINGLE_THREADED
+
+#include <new>
+
+#include "clc/os/RWLock.h"
+
+
+namespace clc
+{
+
+#if !defined(USE_LIBTASK) && !defined(__BEOS__) && !defined(__HAIKU__)
+RWLock::RWLock()
+{
+    if (pthread_rwlock_init(&m_lock, NULL))
+        throw std::bad_alloc();
+}
+
+
+RWLock::~RWLock()
+{
+    int r = pthread_rwlock_destroy(&m_lock);
+    ASSERT(r == 0);(void)r;
+}
+#endif
+
+}
+
+#endif
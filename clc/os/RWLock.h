@@ -0,0 +1,88 @@
+#ifndef LIBCLC_RWLOCK_H
+#define LIBCLC_RWLOCK_H
+
+#include "clc/support/Debug.h"
+
+#if defined(USE_LIBTASK) || defined(__BEOS__) || defined(__HAIKU__)
+#include "clc/os/Lock.h"
+#else
+#include <pthread.h>
+#endif
+
+namespace clc
+{
+
+/**
+ *  A reader/writer lock:  any number of readers, or one writer.
+ *  @note  Where the platform has no native reader/writer lock, readers are serialized too.
+ */
+class RWLock {
+public:
+    /**
+     *  Constructor.  Lock starts out unlocked.
+     *  @throws std::bad_alloc
+     */
+    RWLock();
+
+    /**
+     *  Destructor.  Behavior is undefined if the lock is still locked.
+     */
+    ~RWLock();
+
+    /**
+     *  Locks for reading, blocking while a writer holds the lock.
+     */
+    void readLock();
+
+    /**
+     *  Locks for writing, blocking while any reader or writer holds the lock.
+     */
+    void writeLock();
+
+    /**
+     *  Unlocks the lock, whichever way it was locked.
+     */
+    void unlock();
+
+protected:
+#if defined(USE_LIBTASK) || defined(__BEOS__) || defined(__HAIKU__)
+    Lock m_lock;
+#else
+    pthread_rwlock_t m_lock;
+#endif
+
+private:
+    // Unimplemented
+    RWLock(RWLock const&);
+    RWLock& operator=(RWLock const&);
+};
+
+#if defined(USE_LIBTASK) || defined(__BEOS__) || defined(__HAIKU__)
+inline RWLock::RWLock() {}
+inline RWLock::~RWLock() {}
+inline void RWLock::readLock() { m_lock.lock(); }
+inline void RWLock::writeLock() { m_lock.lock(); }
+inline void RWLock::unlock() { m_lock.unlock(); }
+#else
+inline void RWLock::readLock()
+{
+    int r = pthread_rwlock_rdlock(&m_lock);
+    ASSERT(r == 0);(void)r;
+}
+
+inline void RWLock::writeLock()
+{
+    int r = pthread_rwlock_wrlock(&m_lock);
+    ASSERT(r == 0);(void)r;
+}
+
+inline void RWLock::unlock()
+{
+    int r = pthread_rwlock_unlock(&m_lock);
+    ASSERT(r == 0);(void)r;
+}
+#endif
+
+}
+
+#endif
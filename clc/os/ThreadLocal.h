@@ -0,0 +1,80 @@
+#ifndef LIBCLC_THREADLOCAL_H
+#define LIBCLC_THREADLOCAL_H
+
+#if defined(__BEOS__) || defined(__HAIKU__)
+#include <kernel/OS.h>
+#include <new>
+#elif !defined(USE_LIBTASK)
+#include <pthread.h>
+#include <new>
+#endif
+
+#include "clc/support/Debug.h"
+
+namespace clc
+{
+
+/**
+ *  A pointer-sized slot with a separate value per thread.  Each thread's value starts out NULL.
+ */
+class ThreadLocal {
+public:
+    /**
+     *  @throws std::bad_alloc
+     */
+    ThreadLocal();
+
+    ~ThreadLocal();
+
+    void* get() const;
+
+    void set(void* value);
+
+protected:
+#ifdef USE_LIBTASK
+    void* m_value;  // libtask schedules all tasks on one thread
+#elif defined(__BEOS__) || defined(__HAIKU__)
+    int32 m_key;
+#else
+    pthread_key_t m_key;
+#endif
+
+private:
+    // Unimplemented
+    ThreadLocal(ThreadLocal const&);
+    ThreadLocal& operator=(ThreadLocal const&);
+};
+
+#ifdef USE_LIBTASK
+inline ThreadLocal::ThreadLocal() : m_value(0) {}
+inline ThreadLocal::~ThreadLocal() {}
+inline void* ThreadLocal::get() const { return m_value; }
+inline void ThreadLocal::set(void* value) { m_value = value; }
+#elif defined(__BEOS__) || defined(__HAIKU__)
+inline ThreadLocal::ThreadLocal()
+{
+    m_key = tls_allocate();
+    if (m_key < 0)
+        throw std::bad_alloc();
+}
+inline ThreadLocal::~ThreadLocal() {}
+inline void* ThreadLocal::get() const { return tls_get(m_key); }
+inline void ThreadLocal::set(void* value) { tls_set(m_key, value); }
+#else
+inline ThreadLocal::ThreadLocal()
+{
+    if (pthread_key_create(&m_key, NULL))
+        throw std::bad_alloc();
+}
+inline ThreadLocal::~ThreadLocal() { pthread_key_delete(m_key); }
+inline void* ThreadLocal::get() const { return pthread_getspecific(m_key); }
+inline void ThreadLocal::set(void* value)
+{
+    int r = pthread_setspecific(m_key, value);
+    ASSERT(r == 0);(void)r;
+}
+#endif
+
+}
+
+#endif
@@ -0,0 +1,106 @@
+#if defined(__BEOS__) || defined(__HAIKU__)
+#include <kernel/OS.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "clc/os/Thread.h"
+#include "clc/os/ThreadPool.h"
+#include "clc/support/Debug.h"
+
+
+namespace clc
+{
+
+class PoolWorker : public Thread
+{
+public:
+    PoolWorker() : Thread("pool worker"), m_pool(0), m_id(0) {}
+
+    ThreadPool* m_pool;
+    unsigned int m_id;
+
+protected:
+    void run() { m_pool->work(m_id); }
+};
+
+
+ThreadPool::ThreadPool(unsigned int nThreads) :
+    m_job(0),
+    m_next(0),
+    m_n(0)
+{
+#ifdef SINGLE_THREADED
+    (void)nThreads;
+    m_nThreads = 1;
+#else
+    m_nThreads = nThreads ? nThreads : countCpus();
+#endif
+}
+
+
+void ThreadPool::run(Job& job, unsigned int n)
+{
+    ASSERT(! m_job);
+    m_job = &job;
+    m_next = 0;
+    m_n = n;
+
+    unsigned int nWorkers = m_nThreads < n ? m_nThreads : n;
+    PoolWorker* workers = 0;
+    unsigned int started = 0;
+    if (nWorkers > 1) {
+        workers = new PoolWorker[nWorkers-1];
+        for ( ; started < nWorkers-1; ++started) {
+            workers[started].m_pool = this;
+            workers[started].m_id = started+1;
+            try {
+                workers[started].start();
+            } catch (...) {
+                // Fewer workers; the remaining ones pick up the slack.
+                break;
+            }
+        }
+    }
+
+    work(0);
+
+    for (unsigned int i = 0; i < started; ++i) {
+        workers[i].join();
+    }
+    delete[] workers;
+    m_job = 0;
+}
+
+
+void ThreadPool::work(unsigned int worker)
+{
+    for (;;) {
+        m_lock.lock();
+        unsigned int item = m_next;
+        if (item < m_n)
+            m_next++;
+        m_lock.unlock();
+        if (item >= m_n)
+            break;
+        m_job->run(worker, item);
+    }
+}
+
+
+unsigned int ThreadPool::countCpus()
+{
+    long n;
+#if defined(__BEOS__) || defined(__HAIKU__)
+    system_info info;
+    get_system_info(&info);
+    n = info.cpu_count;
+#elif defined(_SC_NPROCESSORS_ONLN)
+    n = sysconf(_SC_NPROCESSORS_ONLN);
+#else
+    n = 1;
+#endif
+    return n > 0 ? (unsigned int)n : 1;
+}
+
+}
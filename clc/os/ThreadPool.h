@@ -0,0 +1,77 @@
+#ifndef LIBCLC_THREADPOOL_H
+#define LIBCLC_THREADPOOL_H
+
+#include "clc/os/Lock.h"
+
+
+namespace clc
+{
+
+/**
+ *  Runs a batch of independent items on a set of worker threads.  Workers are created per batch
+ *  and joined before run() returns, so no threads linger between batches.
+ */
+class ThreadPool
+{
+public:
+    /**
+     *  One batch of work.
+     */
+    class Job
+    {
+    public:
+        virtual ~Job() {}
+
+        /**
+         *  Processes one item.  Called concurrently from several workers.
+         *  @param worker  Index of the calling worker, in [0, size()).  A worker runs one item at
+         *      a time, so jobs can keep per-worker state without locking.
+         *  @param item  Index of the item, in [0, n).
+         */
+        virtual void run(unsigned int worker, unsigned int item) = 0;
+    };
+
+    /**
+     *  @param nThreads  Number of workers.  0 implies one per online CPU.  Always 1 when built
+     *      SINGLE_THREADED.
+     */
+    ThreadPool(unsigned int nThreads=0);
+
+    /**
+     *  @return Number of workers.
+     */
+    unsigned int size() const { return m_nThreads; }
+
+    /**
+     *  Runs job.run() once for each item in [0, n).  Items are handed out in increasing order.
+     *  The calling thread acts as worker 0, so a pool of size 1 runs everything inline.  Blocks
+     *  until all items have returned.
+     */
+    void run(Job& job, unsigned int n);
+
+    /**
+     *  @return The number of online CPUs (at least 1).
+     */
+    static unsigned int countCpus();
+
+protected:
+    friend class PoolWorker;
+
+    void work(unsigned int worker);
+
+    unsigned int m_nThreads;
+
+    Lock m_lock;
+    Job* m_job;
+    unsigned int m_next;
+    unsigned int m_n;
+
+private:
+    // Unimplemented
+    ThreadPool(ThreadPool const&);
+    ThreadPool& operator=(ThreadPool const&);
+};
+
+}
+
+#endif
@@ -124,6 +124,8 @@ Filesystem::Filesystem()
 #ifdef OCHER_TARGET_KOBO
     m_home = "/mnt/onboard/.ocher";
     m_settings = "/mnt/onboard/.ocher/settings";
+    m_cache = "/mnt/onboard/.ocher/cache";
+    ::mkdir(m_cache, 0775);
 #else
     clc::Buffer s = settingsDir();
     m_home = strdup(s.c_str());
@@ -133,8 +135,12 @@ Filesystem::Filesystem()
     clc::Path::join(s, ".OcherBook");
 #endif
     ::mkdir(s.c_str(), 0775);
+    clc::Buffer c = s;
     clc::Path::join(s, "settings");
     m_settings = strdup(s.c_str());
+    clc::Path::join(c, "cache");
+    ::mkdir(c.c_str(), 0775);
+    m_cache = strdup(c.c_str());
 #endif
 }
 
@@ -146,6 +152,7 @@ Filesystem::~Filesystem()
 #else
     free(m_home);
     free(m_settings);
+    free(m_cache);
 #endif
 }
 
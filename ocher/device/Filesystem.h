@@ -10,6 +10,10 @@ public:
 
     inline const char* getHome() { return m_home; }
     inline const char* getSettings() { return m_settings; }
+    /**
+     * Directory for data that can be regenerated, such as paginations.
+     */
+    inline const char* getCache() { return m_cache; }
 
     const char **ocherLibraries;
 
@@ -17,6 +21,7 @@ protected:
     void mkdirs();
     char* m_home;
     char* m_settings;
+    char* m_cache;
 };
 
 extern struct Filesystem fs;
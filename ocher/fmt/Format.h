@@ -3,6 +3,18 @@
 
 #include "clc/data/Buffer.h"
 
+/**
+ * A font supplied by the document itself, such as an EPUB's @font-face.
+ */
+struct EmbeddedFont
+{
+    EmbeddedFont() : bold(0), italic(0) {}
+    clc::Buffer name;  ///< where the font came from, for diagnostics
+    clc::Buffer data;  ///< contents of the font file
+    int bold;
+    int italic;
+};
+
 /**
  *  Base class for file-format readers.
  */
@@ -1,4 +1,5 @@
 #include <ctype.h>
+#include <string.h>
 
 #include "clc/support/Debug.h"
 #include "clc/support/Logger.h"
@@ -14,14 +15,14 @@ Layout::Layout() :
     m_text(new clc::Buffer),
     m_textLen(0)
 {
-    m_text->lockBuffer(chunk);
+    m_text->lockBuffer(chunk + maxUtf8);
     m_data.lockBuffer(chunk);
 }
 
 Layout::~Layout()
 {
     // Walk the bytecode and delete embedded strings
-    const unsigned int N = m_data.size();
+    const unsigned int N = m_dataLen;
     const char *raw = m_data.data();
     for (unsigned int i = 0; i < N; ) {
         uint16_t code = *(uint16_t*)(raw+i);
@@ -31,6 +32,8 @@ Layout::~Layout()
         if (opType == OpCmd && op == CmdOutputStr) {
             delete *(clc::Buffer**)(raw+i);
             i += sizeof(clc::Buffer*);
+            delete[] *(uint8_t**)(raw+i);
+            i += sizeof(uint8_t*);
         }
     }
 
@@ -43,6 +46,27 @@ clc::Buffer Layout::unlock()
     return m_data;
 }
 
+void Layout::appendFragment(Layout &fragment)
+{
+    flushText();
+    fragment.flushText();
+    char *p = checkAlloc(fragment.m_dataLen);
+    memcpy(p, fragment.m_data.data(), fragment.m_dataLen);
+    // The fragment's strings are now owned by this layout.
+    fragment.m_dataLen = 0;
+
+    nl = fragment.nl;
+    ws = fragment.ws;
+    pre = fragment.pre;
+    m_lineBreak = fragment.m_lineBreak;
+}
+
+void Layout::forcePage()
+{
+    flushText();
+    push(OpCmd, CmdForcePage, 0);
+}
+
 char *Layout::checkAlloc(unsigned int n)
 {
     if (m_dataLen + n > m_data.size()) {
@@ -80,17 +104,21 @@ void Layout::popTextAttr(unsigned int n)
 
 void Layout::pushLineAttr(LineAttr attr, uint8_t arg)
 {
+    // Applies from here on, not to text already output.
+    flushText();
     push(OpPushLineAttr, attr, arg);
 }
 
 void Layout::popLineAttr(unsigned int n)
 {
+    flushText();
     push(OpCmd, CmdPopAttr, n);
 }
 
 inline void Layout::_outputChar(char c)
 {
-    if (m_textLen == chunk) {
+    // Don't split a UTF-8 sequence across strings (unless malformed).
+    if ((m_textLen >= chunk && (c & 0xc0) != 0x80) || m_textLen == chunk + maxUtf8) {
         flushText();
     }
     (*m_text)[m_textLen++] = c;
@@ -130,9 +158,12 @@ void Layout::flushText()
         push(OpCmd, CmdOutputStr, 0);
         m_text->unlockBuffer(m_textLen);
         pushPtr(m_text);
-        // m_text pointer is now owned by the layout bytecode.
+        uint8_t *breaks = new uint8_t[LineBreak::bitmapSize(m_textLen)];
+        m_lineBreak.scan((const unsigned char*)m_text->data(), m_textLen, breaks);
+        pushPtr(breaks);
+        // m_text and breaks pointers are now owned by the layout bytecode.
         m_text = new clc::Buffer;
-        m_text->lockBuffer(chunk);
+        m_text->lockBuffer(chunk + maxUtf8);
         m_textLen = 0;
     }
 }
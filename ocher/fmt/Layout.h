@@ -6,6 +6,8 @@
 
 #include "clc/data/Buffer.h"
 
+#include "ocher/fmt/LineBreak.h"
+
 /**
  *  Contains the rough layout of the book's chapters in a file format independent and output device
  *  independent format.  Once the book is laid out in this format, the original file can be
@@ -51,8 +53,8 @@ public:
 
     enum Cmd {
         CmdPopAttr,            ///< arg: # attrs to pop (0==1)
-        CmdOutputStr,          ///< followed by ptr to Buffer
-        CmdForcePage,          ///< optionally set new title
+        CmdOutputStr,          ///< followed by ptr to Buffer, then ptr to its LineBreak bitmap
+        CmdForcePage,          ///< starts a new page, outside of any attrs; optionally set new title
     };
 
     enum Spacing {
@@ -66,11 +68,31 @@ public:
         // hr
     };
 
+    /**
+     *  Bump whenever a book's bytecode, or how renderers break it into pages, changes; persisted
+     *  paginations of other versions are then discarded.
+     */
+    static const unsigned int version = 2;
+
     Layout();
     ~Layout();
 
     //virtual void append(...) = 0;
 
+    /**
+     *  Moves a separately laid out fragment (for example, a chapter laid out on another thread)
+     *  to the end of this layout.  The bytecode holds no absolute offsets, so it is copied as is;
+     *  ownership of its strings passes to this layout, and the fragment is left empty.  The text
+     *  state (pending newline, whitespace) continues from the end of the fragment.
+     */
+    void appendFragment(Layout &fragment);
+
+    /**
+     *  Starts a new page, for example for a chapter.  Attributes must not be open.  Chapters
+     *  thus paginate independently of each other.
+     */
+    void forcePage();
+
     clc::Buffer unlock();
 
 protected:
@@ -99,8 +121,10 @@ protected:
     int pre;
     clc::Buffer *m_text;
     unsigned int m_textLen;
+    LineBreak m_lineBreak;
 
     static const unsigned int chunk = 1024;
+    static const unsigned int maxUtf8 = 6;  ///< slack so that chunks end on a UTF-8 boundary
 };
 
 #endif
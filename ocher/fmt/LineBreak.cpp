@@ -0,0 +1,259 @@
+#include <string.h>
+
+#include "clc/support/Debug.h"
+
+#include "ocher/fmt/LineBreak.h"
+
+
+LineBreak::LineBreak() :
+    m_cls(WJ),
+    m_sp(false),
+    m_start(true)
+{
+}
+
+LineBreak::Class LineBreak::classify(uint32_t c)
+{
+    static const uint8_t asciiClass[128] = {
+        CM, CM, CM, CM, CM, CM, CM, CM,  // 00
+        CM, BA, BK, BK, BK, BK, CM, CM,  // 08
+        CM, CM, CM, CM, CM, CM, CM, CM,  // 10
+        CM, CM, CM, CM, CM, CM, CM, CM,  // 18
+        SP, EX, QU, AL, PR, PO, AL, QU,  // 20
+        OP, CP, AL, PR, IS, HY, IS, SY,  // 28
+        NU, NU, NU, NU, NU, NU, NU, NU,  // 30
+        NU, NU, IS, IS, AL, AL, AL, EX,  // 38
+        AL, AL, AL, AL, AL, AL, AL, AL,  // 40
+        AL, AL, AL, AL, AL, AL, AL, AL,  // 48
+        AL, AL, AL, AL, AL, AL, AL, AL,  // 50
+        AL, AL, AL, OP, PR, CP, AL, AL,  // 58
+        AL, AL, AL, AL, AL, AL, AL, AL,  // 60
+        AL, AL, AL, AL, AL, AL, AL, AL,  // 68
+        AL, AL, AL, AL, AL, AL, AL, AL,  // 70
+        AL, AL, AL, OP, BA, CL, AL, CM,  // 78
+    };
+
+    struct ClassRange {
+        uint32_t first;
+        uint32_t last;
+        uint8_t cls;
+    };
+
+    /** Sorted; anything not listed is AL. */
+    static const ClassRange ranges[] = {
+        { 0x00a0, 0x00a0, GL }, { 0x00a1, 0x00a1, OP }, { 0x00a2, 0x00a2, PO },
+        { 0x00a3, 0x00a5, PR }, { 0x00ab, 0x00ab, QU }, { 0x00ad, 0x00ad, BA },
+        { 0x00b0, 0x00b0, PO }, { 0x00b1, 0x00b1, PR }, { 0x00b4, 0x00b4, BB },
+        { 0x00bb, 0x00bb, QU }, { 0x00bf, 0x00bf, OP },
+        { 0x0300, 0x036f, CM }, { 0x0483, 0x0489, CM }, { 0x0591, 0x05bd, CM },
+        { 0x1680, 0x1680, BA },
+        { 0x2000, 0x2006, BA }, { 0x2007, 0x2007, GL }, { 0x2008, 0x200a, BA },
+        { 0x200b, 0x200b, ZW }, { 0x200c, 0x200d, CM }, { 0x2010, 0x2010, BA },
+        { 0x2011, 0x2011, GL }, { 0x2012, 0x2013, BA }, { 0x2014, 0x2014, B2 },
+        { 0x2018, 0x2019, QU }, { 0x201a, 0x201a, OP }, { 0x201b, 0x201d, QU },
+        { 0x201e, 0x201e, OP }, { 0x201f, 0x201f, QU }, { 0x2024, 0x2026, IN },
+        { 0x2028, 0x2029, BK }, { 0x202f, 0x202f, GL }, { 0x2030, 0x2037, PO },
+        { 0x2039, 0x203a, QU }, { 0x203c, 0x203d, NS }, { 0x2044, 0x2044, IS },
+        { 0x2060, 0x2060, WJ }, { 0x20a0, 0x20cf, PR },
+        { 0x2e80, 0x2fff, ID },
+        { 0x3000, 0x3000, BA }, { 0x3001, 0x3002, CL }, { 0x3003, 0x3004, ID },
+        { 0x3005, 0x3005, NS }, { 0x3006, 0x3007, ID },
+        { 0x3008, 0x3008, OP }, { 0x3009, 0x3009, CL }, { 0x300a, 0x300a, OP },
+        { 0x300b, 0x300b, CL }, { 0x300c, 0x300c, OP }, { 0x300d, 0x300d, CL },
+        { 0x300e, 0x300e, OP }, { 0x300f, 0x300f, CL }, { 0x3010, 0x3010, OP },
+        { 0x3011, 0x3011, CL }, { 0x3012, 0x3013, ID }, { 0x3014, 0x3014, OP },
+        { 0x3015, 0x3015, CL }, { 0x3016, 0x3016, OP }, { 0x3017, 0x3017, CL },
+        { 0x3018, 0x3018, OP }, { 0x3019, 0x3019, CL }, { 0x301a, 0x301a, OP },
+        { 0x301b, 0x301b, CL }, { 0x301c, 0x301c, NS }, { 0x301d, 0x301d, OP },
+        { 0x301e, 0x301f, CL }, { 0x3020, 0x3029, ID }, { 0x302a, 0x302f, CM },
+        { 0x3030, 0x303a, ID }, { 0x303b, 0x303c, NS }, { 0x303d, 0x309a, ID },
+        { 0x309b, 0x309e, NS }, { 0x309f, 0x309f, ID }, { 0x30a0, 0x30a0, NS },
+        { 0x30a1, 0x30fa, ID }, { 0x30fb, 0x30fe, NS }, { 0x30ff, 0x4dbf, ID },
+        { 0x4e00, 0x9fff, ID }, { 0xa000, 0xa4cf, ID }, { 0xac00, 0xd7a3, ID },
+        { 0xf900, 0xfaff, ID }, { 0xfe30, 0xfe4f, ID }, { 0xfeff, 0xfeff, WJ },
+        { 0xff01, 0xff01, EX }, { 0xff02, 0xff07, ID }, { 0xff08, 0xff08, OP },
+        { 0xff09, 0xff09, CP }, { 0xff0a, 0xff0b, ID }, { 0xff0c, 0xff0c, CL },
+        { 0xff0d, 0xff0d, ID }, { 0xff0e, 0xff0e, CL }, { 0xff0f, 0xff19, ID },
+        { 0xff1a, 0xff1b, NS }, { 0xff1c, 0xff1e, ID }, { 0xff1f, 0xff1f, EX },
+        { 0xff20, 0xff3a, ID }, { 0xff3b, 0xff3b, OP }, { 0xff3c, 0xff3c, ID },
+        { 0xff3d, 0xff3d, CP }, { 0xff3e, 0xff5a, ID }, { 0xff5b, 0xff5b, OP },
+        { 0xff5c, 0xff5c, ID }, { 0xff5d, 0xff5d, CL }, { 0xff5e, 0xff60, ID },
+        { 0x1f000, 0x1faff, ID }, { 0x20000, 0x2fffd, ID }, { 0x30000, 0x3fffd, ID },
+    };
+
+    if (c < 0x80)
+        return (Class)asciiClass[c];
+
+    int lo = 0;
+    int hi = sizeof(ranges)/sizeof(ranges[0]) - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        if (c < ranges[mid].first)
+            hi = mid - 1;
+        else if (c > ranges[mid].last)
+            lo = mid + 1;
+        else
+            return (Class)ranges[mid].cls;
+    }
+    return AL;
+}
+
+void LineBreak::scan(const unsigned char *text, unsigned int len, uint8_t *bits)
+{
+    /**
+     * The UAX #14 pair table, indexed [before][after]:
+     *  _  direct break
+     *  %  indirect break (only across spaces)
+     *  #  indirect break before a combining mark
+     *  ^  prohibited
+     *  @  prohibited, before a combining mark
+     */
+    static const char pairs[22][23] = {
+        // OP CL CP QU GL NS EX SY IS PR PO NU AL ID IN HY BA BB B2 ZW CM WJ
+        "^^^^^^^^^^^^^^^^^^^^@^",  // OP
+        "_^^%%^^^^%%____%%__^#^",  // CL
+        "_^^%%^^^^%%%%__%%__^#^",  // CP
+        "^^^%%%^^^%%%%%%%%%%^#^",  // QU
+        "%^^%%%^^^%%%%%%%%%%^#^",  // GL
+        "_^^%%%^^^______%%__^#^",  // NS
+        "_^^%%%^^^______%%__^#^",  // EX
+        "_^^%%%^^^__%___%%__^#^",  // SY
+        "_^^%%%^^^__%%__%%__^#^",  // IS
+        "%^^%%%^^^__%%%_%%__^#^",  // PR
+        "%^^%%%^^^__%%__%%__^#^",  // PO
+        "%^^%%%^^^%%%%_%%%__^#^",  // NU
+        "%^^%%%^^^__%%_%%%__^#^",  // AL
+        "_^^%%%^^^_%___%%%__^#^",  // ID
+        "_^^%%%^^^_____%%%__^#^",  // IN
+        "_^^%_%^^^__%___%%__^#^",  // HY
+        "_^^%_%^^^______%%__^#^",  // BA
+        "%^^%%%^^^%%%%%%%%%%^#^",  // BB
+        "_^^%%%^^^______%%_^^#^",  // B2
+        "___________________^__",  // ZW
+        "%^^%%%^^^__%%_%%%__^#^",  // CM
+        "%^^%%%^^^%%%%%%%%%%^#^",  // WJ
+    };
+
+    memset(bits, 0, bitmapSize(len));
+
+    for (unsigned int i = 0; i < len; ) {
+        const unsigned int at = i;
+        uint32_t c = text[i++];
+        if (c >= 0x80) {
+            // Decode UTF-8; a malformed sequence is taken a byte at a time.
+            unsigned int n = 0;
+            if ((c & 0xe0) == 0xc0) {
+                c &= 0x1f;
+                n = 1;
+            } else if ((c & 0xf0) == 0xe0) {
+                c &= 0x0f;
+                n = 2;
+            } else if ((c & 0xf8) == 0xf0) {
+                c &= 0x07;
+                n = 3;
+            }
+            if (i + n > len)
+                n = 0;
+            for (unsigned int j = 0; j < n; ++j)
+                c = (c << 6) | (text[i++] & 0x3f);
+        }
+
+        Class cls = classify(c);
+        if (m_start) {
+            // Never break before the first character of the text.
+            m_start = false;
+            m_cls = (cls == SP) ? WJ : cls;
+            continue;
+        }
+        if (m_cls == BK) {
+            // After a mandatory break; the renderer breaks, but record it anyway.
+            if (cls == BK && c == '\n' && at && text[at-1] == '\r') {
+                continue;  // CR LF
+            }
+            bits[at >> 3] |= 1 << (at & 7);
+            m_cls = (cls == SP) ? WJ : cls;
+            m_sp = false;
+            continue;
+        }
+        if (cls == SP) {
+            m_sp = true;
+            continue;
+        }
+        if (cls == BK) {
+            m_cls = BK;
+            m_sp = false;
+            continue;
+        }
+
+        bool brk;
+        switch (pairs[m_cls][cls]) {
+            case '_':
+                brk = true;
+                break;
+            case '%':
+                brk = m_sp;
+                break;
+            case '#':
+            case '@':
+                // A combining mark takes on the class of its base, unless it follows spaces, in
+                // which case it acts as AL.
+                if (! m_sp)
+                    continue;
+                brk = pairs[m_cls][AL] != '^';
+                cls = AL;
+                break;
+            default:
+                brk = false;
+                break;
+        }
+        if (brk)
+            bits[at >> 3] |= 1 << (at & 7);
+        m_cls = cls;
+        m_sp = false;
+    }
+}
+
+unsigned int LineBreak::next(const uint8_t *bits, unsigned int from, unsigned int len)
+{
+    for (unsigned int i = from + 1; i < len; ++i) {
+        if (! bits[i >> 3]) {
+            // Skip the rest of an empty byte.
+            i |= 7;
+            continue;
+        }
+        if (isBreak(bits, i))
+            return i;
+    }
+    return len;
+}
+
+int LineBreak::prev(const uint8_t *bits, unsigned int hi, unsigned int lo)
+{
+    for (int i = hi; i >= (int)lo; --i) {
+        if (isBreak(bits, i))
+            return i;
+    }
+    return -1;
+}
+
+unsigned int LineBreak::fit(const unsigned char *text, unsigned int len, const uint8_t *bits,
+        unsigned int off, unsigned int n, bool lineStarted)
+{
+    ASSERT(off + n <= len);
+    unsigned int end = off + n;
+    if (end == len)
+        return n;
+
+    // Spaces hang:  if only spaces separate the end of the line from an opportunity (or a
+    // mandatory break), it fits.
+    unsigned int k = end;
+    while (k < len && text[k] == ' ')
+        ++k;
+    if (k == len || text[k] == '\n' || isBreak(bits, k))
+        return n;
+
+    int brk = prev(bits, end, lineStarted ? off : off + 1);
+    if (brk < 0)
+        return n;
+    return brk - off;
+}
@@ -0,0 +1,71 @@
+#ifndef OCHER_FMT_LINEBREAK_H
+#define OCHER_FMT_LINEBREAK_H
+
+/** @file Line-break opportunities.
+ */
+
+#include <stdint.h>
+
+
+/**
+ *  Finds line-break opportunities in UTF-8 text, following the pair table of UAX #14 (Unicode
+ *  Line Breaking Algorithm) over a subset of its classes.  Complex-context scripts (SA) are
+ *  treated as alphabetic, and conjoining jamo and regional indicators are not distinguished.
+ *
+ *  The result is a bitmap with one bit per byte of the run:  bit i is set if a line may break
+ *  before byte i.  Mandatory breaks ('\n') are left to the renderer.  Scanning state carries from
+ *  one run to the next, so a run's bit 0 reflects the text before it.
+ */
+class LineBreak
+{
+public:
+    enum Class {
+        // Classes in the pair table:
+        OP, CL, CP, QU, GL, NS, EX, SY, IS, PR, PO, NU, AL, ID, IN, HY, BA, BB, B2, ZW, CM, WJ,
+        // Resolved before the pair table is consulted:
+        SP, BK,
+    };
+
+    LineBreak();
+
+    static Class classify(uint32_t c);
+
+    /**
+     *  Computes the break bitmap of the next run of text.
+     *  @param bits  Receives bitmapSize(len) bytes.
+     */
+    void scan(const unsigned char *text, unsigned int len, uint8_t *bits);
+
+    static unsigned int bitmapSize(unsigned int len) { return (len + 7) / 8; }
+
+    static bool isBreak(const uint8_t *bits, unsigned int i) {
+        return bits[i >> 3] & (1 << (i & 7));
+    }
+
+    /**
+     *  @return The first break in (from, len), else len.
+     */
+    static unsigned int next(const uint8_t *bits, unsigned int from, unsigned int len);
+
+    /**
+     *  @return The last break in [lo, hi], else -1.
+     */
+    static int prev(const uint8_t *bits, unsigned int hi, unsigned int lo);
+
+    /**
+     *  For fixed-pitch output:  how many bytes of text, starting at off, to place on a line with
+     *  room for n more.  Breaks at the last opportunity that fits; spaces may hang past the end of
+     *  the line.  Falls back to n (breaking a word) if there is no opportunity.
+     *  @param lineStarted  The line already holds text, so a break at off itself is usable.
+     *  @return Bytes for this line; may be 0 if lineStarted.
+     */
+    static unsigned int fit(const unsigned char *text, unsigned int len, const uint8_t *bits,
+            unsigned int off, unsigned int n, bool lineStarted);
+
+protected:
+    Class m_cls;   ///< class governing the next pair lookup
+    bool m_sp;     ///< spaces since m_cls
+    bool m_start;  ///< no text seen yet
+};
+
+#endif
@@ -1,4 +1,7 @@
+#include <ctype.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "mxml.h"
 
@@ -184,6 +187,7 @@ int Epub::getSpineItemByIndex(unsigned int i, clc::Buffer &item)
         clc::Buffer &idref = m_spine[i];
         std::map<clc::Buffer,EpubItem>::iterator it = m_items.find(idref);
         if (it != m_items.end()) {
+            clc::Locker locker(m_zipLock);
             TreeFile *f = m_zip.getFile((*it).second.href.c_str(), m_contentPath.c_str());
             if (f) {
                 item = f->data;
@@ -211,6 +215,127 @@ int Epub::getContentByHref(const char *href, clc::Buffer &item)
     return -1;
 }
 
+/**
+ * Resolves href relative to the file base, both relative to the content path.
+ */
+static clc::Buffer resolveHref(const char *base, const char *href)
+{
+    std::vector<clc::Buffer> parts;
+    clc::Buffer path;
+    const char *slash = strrchr(base, '/');
+    if (slash)
+        path.setTo(base, slash - base + 1);
+    path.append(href);
+
+    const char *p = path.c_str();
+    while (*p) {
+        const char *e = strchr(p, '/');
+        size_t n = e ? e - p : strlen(p);
+        if (n == 2 && strncmp(p, "..", 2) == 0) {
+            if (! parts.empty())
+                parts.pop_back();
+        } else if (n && ! (n == 1 && *p == '.')) {
+            parts.push_back(clc::Buffer(p, n));
+        }
+        p += n;
+        if (*p)
+            ++p;
+    }
+    clc::Buffer resolved;
+    for (unsigned int i = 0; i < parts.size(); ++i) {
+        if (i)
+            resolved.append("/");
+        resolved.append(parts[i]);
+    }
+    return resolved;
+}
+
+/**
+ * @return The value of the CSS declaration within [p, end), without surrounding whitespace and
+ *      quotes.
+ */
+static clc::Buffer cssValue(const char *p, const char *end, const char *property)
+{
+    size_t n = strlen(property);
+    for ( ; p + n < end; ++p) {
+        if (strncasecmp(p, property, n) == 0 && (p[n] == ':' || isspace(p[n]))) {
+            p += n;
+            while (p < end && (isspace(*p) || *p == ':'))
+                ++p;
+            const char *e = p;
+            while (e < end && *e != ';')
+                ++e;
+            while (e > p && isspace(e[-1]))
+                --e;
+            return clc::Buffer(p, e - p);
+        }
+    }
+    return clc::Buffer();
+}
+
+/**
+ * @return The first url() of a CSS src value that FreeType can open.
+ */
+static clc::Buffer cssFontUrl(const char *src)
+{
+    const char *p = src;
+    while ((p = strstr(p, "url(")) != 0) {
+        p += 4;
+        while (isspace(*p) || *p == '"' || *p == '\'')
+            ++p;
+        const char *e = p;
+        while (*e && *e != ')' && *e != '"' && *e != '\'')
+            ++e;
+        clc::Buffer url(p, e - p);
+        if (url.IFindFirst(".woff") == clc::Buffer::NotFound &&
+                url.IFindFirst(".svg") == clc::Buffer::NotFound &&
+                url.IFindFirst(".eot") == clc::Buffer::NotFound)
+            return url;
+        p = e;
+    }
+    return clc::Buffer();
+}
+
+void Epub::getFonts(std::list<EmbeddedFont> &fonts)
+{
+    for (std::map<clc::Buffer, EpubItem>::iterator it = m_items.begin(); it != m_items.end(); ++it) {
+        EpubItem &item = (*it).second;
+        if (item.mediaType != "text/css")
+            continue;
+        clc::Buffer css = getFile(item.href.c_str());
+        const char *text = css.c_str();
+        size_t pos = 0;
+        while ((pos = css.IFindFirst("@font-face", pos)) != clc::Buffer::NotFound) {
+            const char *begin = strchr(text + pos, '{');
+            if (! begin)
+                break;
+            const char *end = strchr(begin, '}');
+            if (! end)
+                break;
+            pos = end - text;
+
+            clc::Buffer url = cssFontUrl(cssValue(begin + 1, end, "src").c_str());
+            if (url.empty())
+                continue;
+            EmbeddedFont font;
+            font.name = resolveHref(item.href.c_str(), url.c_str());
+            font.data = getFile(font.name.c_str());
+            if (font.data.empty()) {
+                clc::Log::warn("ocher.epub", "Missing font '%s'", font.name.c_str());
+                continue;
+            }
+            clc::Buffer weight = cssValue(begin + 1, end, "font-weight");
+            font.bold = weight.IFindFirst("bold") != clc::Buffer::NotFound || atoi(weight.c_str()) >= 600;
+            clc::Buffer style = cssValue(begin + 1, end, "font-style");
+            font.italic = style.IFindFirst("italic") != clc::Buffer::NotFound ||
+                style.IFindFirst("oblique") != clc::Buffer::NotFound;
+            clc::Log::debug("ocher.epub", "Found font '%s' bold %d italic %d", font.name.c_str(),
+                    font.bold, font.italic);
+            fonts.push_back(font);
+        }
+    }
+}
+
 Epub::Epub(const char *filename, const char *password) :
     m_zip(filename, password)
 {
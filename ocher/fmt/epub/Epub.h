@@ -1,10 +1,12 @@
 #ifndef OCHER_EPUB_PARSER_H
 #define OCHER_EPUB_PARSER_H
 
+#include <list>
 #include <map>
 #include <vector>
 
 #include "clc/data/Buffer.h"
+#include "clc/os/Lock.h"
 
 #include "ocher/fmt/Format.h"
 #include "ocher/fmt/epub/UnzipCache.h"
@@ -29,6 +31,7 @@ public:
     clc::Buffer m_title;
 
     clc::Buffer getFile(const char *filename) {
+        clc::Locker locker(m_zipLock);
         TreeFile *f = m_zip.getFile(filename, m_contentPath.c_str());
         clc::Buffer b;
         if (f) {
@@ -37,10 +40,17 @@ public:
         return b;
     }
 
+    unsigned int getSpineSize() const { return m_spine.size(); }
     int getSpineItemByIndex(unsigned int i, clc::Buffer &item);
     int getManifestItemById(unsigned int i, clc::Buffer &item);
     int getContentByHref(const char *href, clc::Buffer &item);
 
+    /**
+     * Finds the fonts declared by @font-face rules in the book's stylesheets.  The font data
+     * is shared with the unzip cache, not copied.
+     */
+    void getFonts(std::list<EmbeddedFont> &fonts);
+
     /**
      * Parses XML. Caller must call mxml_delete.
      */
@@ -50,6 +60,7 @@ protected:
     TreeFile* findSpine();
     void parseSpine(TreeFile* spine);
 
+    clc::Lock m_zipLock;  ///< UnzipCache is not thread-safe
     UnzipCache m_zip;
     std::map<clc::Buffer, EpubItem> m_items;
     std::vector<clc::Buffer> m_spine;
@@ -1,5 +1,6 @@
 #include "mxml.h"
 
+#include "clc/os/ThreadPool.h"
 #include "clc/support/Logger.h"
 
 #include "ocher/fmt/epub/Epub.h"
@@ -12,11 +13,50 @@
 // TODO:  canonicalize:  HTML escapes, ...
 
 
+/**
+ * @return The justification asked for by an element's align attribute or the text-align in its
+ *      style attribute, or -1.
+ */
+static int justification(mxml_node_t *node)
+{
+    const char *align = mxmlElementGetAttr(node, "align");
+    const char *style = mxmlElementGetAttr(node, "style");
+    if (style) {
+        const char *t = strstr(style, "text-align");
+        if (t) {
+            t += strlen("text-align");
+            while (*t == ' ' || *t == ':')
+                ++t;
+            align = t;
+        }
+    }
+    if (! align)
+        return -1;
+    if (strncasecmp(align, "left", 4) == 0)
+        return Layout::LineJustifyLeft;
+    if (strncasecmp(align, "center", 6) == 0)
+        return Layout::LineJustifyCenter;
+    if (strncasecmp(align, "right", 5) == 0)
+        return Layout::LineJustifyRight;
+    if (strncasecmp(align, "justify", 7) == 0)
+        return Layout::LineJustifyFull;
+    return -1;
+}
+
 void LayoutEpub::processNode(mxml_node_t *node)
 {
     if (node->type == MXML_ELEMENT) {
         const char *name = node->value.element.name;
         clc::Log::trace("ocher.fmt.epub.layout", "found element '%s'", name);
+        int justify = strcasecmp(name, "center") == 0 ? LineJustifyCenter : justification(node);
+        const int enclosing = m_justify;
+        if (justify == enclosing)
+            justify = -1;  // already in effect; no frame needed
+        if (justify >= 0) {
+            pushLineAttr((LineAttr)justify, 0);
+            m_justify = justify;
+        }
+
         if (strcasecmp(name, "div") == 0) {
             processSiblings(node->child);
         } else if (strcasecmp(name, "title") == 0) {
@@ -62,6 +102,11 @@ void LayoutEpub::processNode(mxml_node_t *node)
         } else {
             processSiblings(node->child);
         }
+
+        if (justify >= 0) {
+            popLineAttr();
+            m_justify = enclosing;
+        }
     } else if (node->type == MXML_OPAQUE) {
         clc::Log::trace("ocher.fmt.epub.layout", "found opaque");
         for (char *p = node->value.opaque; *p; ++p) {
@@ -90,4 +135,55 @@ void LayoutEpub::append(mxml_node_t *tree)
     }
 }
 
+class LayoutEpub::SpineJob : public clc::ThreadPool::Job
+{
+public:
+    SpineJob(Epub *epub, LayoutEpub **fragments) : m_epub(epub), m_fragments(fragments) {}
 
+    void run(unsigned int worker, unsigned int i)
+    {
+        (void)worker;
+        clc::Buffer html;
+        if (m_epub->getSpineItemByIndex(i, html) != 0)
+            return;
+        mxml_node_t *tree = m_epub->parseXml(html);
+        if (tree) {
+            LayoutEpub *fragment = new LayoutEpub(m_epub);
+            // Each spine item starts on a fresh line.
+            fragment->nl = 1;
+            fragment->append(tree);
+            mxmlDelete(tree);
+            m_fragments[i] = fragment;
+        } else {
+            clc::Log::warn("ocher.fmt.epub.layout", "No tree found for spine item %u", i);
+        }
+    }
+
+protected:
+    Epub *m_epub;
+    LayoutEpub **m_fragments;
+};
+
+void LayoutEpub::appendSpine()
+{
+    const unsigned int n = m_epub->getSpineSize();
+    LayoutEpub **fragments = new LayoutEpub*[n]();
+
+    clc::ThreadPool pool;
+    clc::Log::debug("ocher.fmt.epub.layout", "Laying out %u spine items on %u workers", n, pool.size());
+    SpineJob job(m_epub, fragments);
+    pool.run(job, n);
+
+    bool first = true;
+    for (unsigned int i = 0; i < n; ++i) {
+        if (fragments[i]) {
+            // Each spine item (chapter) starts a page.
+            if (! first)
+                forcePage();
+            first = false;
+            appendFragment(*fragments[i]);
+            delete fragments[i];
+        }
+    }
+    delete[] fragments;
+}
@@ -9,15 +9,24 @@ class Epub;
 class LayoutEpub : public Layout
 {
 public:
-    LayoutEpub(Epub *epub) : m_epub(epub) {}
+    LayoutEpub(Epub *epub) : m_epub(epub), m_justify(-1) {}
 
     void append(mxml_node_t *tree);
 
+    /**
+     *  Lays out every spine item.  Each item is laid out into its own fragment (with its own
+     *  parser and text state) on a ThreadPool, and the fragments are appended in spine order.
+     */
+    void appendSpine();
+
 protected:
+    class SpineJob;
+
     void processNode(mxml_node_t *node);
     void processSiblings(mxml_node_t *node);
 
     Epub *m_epub;
+    int m_justify;  ///< LineAttr of the innermost element setting one, or -1
 };
 
 #endif
@@ -1,4 +1,5 @@
 #include <fnmatch.h>
+#include <string.h>
 
 #include "clc/support/Logger.h"
 #include "clc/storage/Path.h"
@@ -109,6 +110,7 @@ int UnzipCache::unzipFile(const char *pattern, clc::Buffer *matchedName)
 
     if (tfile) {
         char * buf = buffer.lockBuffer(file_info.uncompressed_size);
+        size_t len = 0;
 
         err = unzOpenCurrentFilePassword(m_uf, m_password.empty() ? NULL : m_password.c_str());
         if (err != UNZ_OK) {
@@ -117,13 +119,17 @@ int UnzipCache::unzipFile(const char *pattern, clc::Buffer *matchedName)
             clc::Log::info("ocher.epub.unzip", "extracting: %s", pathname);
 
             do {
-                err = unzReadCurrentFile(m_uf, buf, buffer.size());
+                err = unzReadCurrentFile(m_uf, buf + len, file_info.uncompressed_size - len);
                 if (err < 0) {
                     clc::Log::error("ocher.epub.unzip", "unzReadCurrentFile: %d", err);
+                } else {
+                    len += err;
                 }
             } while (err > 0);
         }
-        buffer.unlockBuffer();
+        // Explicit length, since fonts and images contain NULs.
+        buf[len] = '\0';
+        buffer.unlockBuffer(len);
         tfile->data = buffer;
 
         if (err == UNZ_OK) {
@@ -138,20 +144,61 @@ int UnzipCache::unzipFile(const char *pattern, clc::Buffer *matchedName)
     return err == UNZ_OK ? match : -1;
 }
 
+bool UnzipCache::open()
+{
+    if (m_uf)
+        return true;
+    m_uf = unzOpen64(m_filename.c_str());
+    if (! m_uf) {
+        clc::Log::error("ocher.epub.unzip", "unzOpen: %s", m_filename.c_str());
+        return false;
+    }
+    for (int err = unzGoToFirstFile(m_uf); err == UNZ_OK; err = unzGoToNextFile(m_uf)) {
+        char pathname[256];
+        unz64_file_pos pos;
+        if (unzGetCurrentFileInfo64(m_uf, NULL, pathname, sizeof(pathname), NULL, 0, NULL, 0) ==
+                UNZ_OK && unzGetFilePos64(m_uf, &pos) == UNZ_OK)
+            m_index.insert(std::make_pair(clc::Buffer(pathname), pos));
+    }
+    return true;
+}
+
 int UnzipCache::unzip(const char *pattern, std::list<clc::Buffer> *matchedNames)
 {
     uLong i;
     unz_global_info64 gi;
     int numMatched = 0;
 
-    if (m_uf)
-        unzClose(m_uf);
-    m_uf = unzOpen64(m_filename.c_str());
+    if (! open())
+        return -1;
+
+    // A plain name is looked up, rather than matched against every entry.  Opening every
+    // chapter of a long book would otherwise take time quadratic in its length.
+    if (pattern && ! strpbrk(pattern, "*?[")) {
+        std::map<clc::Buffer, unz64_file_pos>::const_iterator it = m_index.find(clc::Buffer(pattern));
+        if (it == m_index.end())
+            return 0;
+        if (unzGoToFilePos64(m_uf, &it->second) != UNZ_OK) {
+            clc::Log::error("ocher.epub.unzip", "unzGoToFilePos: %s", pattern);
+            return -1;
+        }
+        clc::Buffer matchedName;
+        int r = unzipFile(pattern, &matchedName);
+        if (matchedNames && !matchedName.empty())
+            matchedNames->push_back(matchedName);
+        return r > 0 ? 1 : r;
+    }
+
     int err = unzGetGlobalInfo64(m_uf, &gi);
     if (err != UNZ_OK) {
         clc::Log::error("ocher.epub.unzip", "unzGetGlobalInfo: %d", err);
         return -1;
     }
+    err = unzGoToFirstFile(m_uf);
+    if (err != UNZ_OK) {
+        clc::Log::error("ocher.epub.unzip", "unzGoToFirstFile: %d", err);
+        return -1;
+    }
 
     for (i = 0; i < gi.number_entry; i++) {
         int r;
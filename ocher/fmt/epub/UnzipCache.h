@@ -2,6 +2,7 @@
 #define OCHER_UNZIP_CACHE_H
 
 #include <list>
+#include <map>
 
 #include "unzip.h"
 #include "clc/data/Buffer.h"
@@ -39,7 +40,14 @@ protected:
      */
     int unzip(const char *pattern, std::list<clc::Buffer> *matchedNames);
 
+    /**
+     * Opens the zip, if not already, and indexes its entries by name.
+     * @return false on error
+     */
+    bool open();
+
     unzFile m_uf;
+    std::map<clc::Buffer, unz64_file_pos> m_index;  ///< so that files are found without a scan
     TreeDirectory* m_root;
     clc::Buffer m_filename;
     clc::Buffer m_password;
@@ -1,6 +1,8 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <getopt.h>
+#include <vector>
 
 #include "airbag_fd/airbag_fd.h"
 
@@ -13,6 +15,9 @@
 #include "ocher/settings/Settings.h"
 #include "ocher/ux/Controller.h"
 #include "ocher/ux/Factory.h"
+#ifdef OCHER_UI_FD
+#include "ocher/ux/fd/Export.h"
+#endif
 
 struct Options opt;
 
@@ -68,6 +73,15 @@ void usage(const char *msg)
         "   --list-drivers    List all available output drivers.  Each driver consists of\n"
         "                     a font renderer driving a hardware device.\n"
         "   --driver <driver>\n"
+        "   --size <w>x<h>    Page size, in pixels, for the memory driver.\n"
+        "   --dpi <dpi>       Resolution for the memory driver.\n"
+        "   --dump <dir>      Write each page the memory driver renders to dir, as\n"
+        "                     pageNNNN.<format> numbered from 0.\n"
+        "   --dump-format <format> Dump pages as png (the default) or pgm.\n"
+        "   --export <format> Write the books (or those in the directory) to stdout as\n"
+        "                     text or ansi (text styled with escapes), without paging.\n"
+        "   --export-dir <dir> Export each book to dir (as its name plus .txt) in parallel,\n"
+        "                     as text unless --export says otherwise.\n"
       //"-w             Allow re-writing the epubs.\n"
         "<file>         \n"
     );
@@ -76,9 +90,45 @@ void usage(const char *msg)
 
 #define OPT_DRIVER 256
 #define OPT_LIST_DRIVERS 257
+#define OPT_SIZE 258
+#define OPT_DPI 259
+#define OPT_DUMP 260
+#define OPT_EXPORT 261
+#define OPT_EXPORT_DIR 262
+#define OPT_DUMP_FORMAT 263
 
 clc::List drivers;
 
+/**
+ * Exports the books named by the rest of the arguments (and -d) without a driver.
+ * @return The exit status
+ */
+int exportBooks(int argc, char **argv)
+{
+#ifdef OCHER_UI_FD
+    std::vector<clc::Buffer> files;
+    if (opt.dir && Export::list(opt.dir, files) != 0) {
+        fprintf(stderr, "Cannot list %s\n", opt.dir);
+        return 1;
+    }
+    for (int i = 0; i < argc; ++i)
+        files.push_back(clc::Buffer(argv[i]));
+    if (files.empty())
+        usage("Please specify an epub file or directory.");
+
+    Export exporter(strcmp(opt.exportFormat, "ansi") == 0, opt.exportDir);
+    unsigned int failed = exporter.run(files);
+    if (failed)
+        fprintf(stderr, "%u of %u books failed to export\n", failed, (unsigned int)files.size());
+    return failed ? 1 : 0;
+#else
+    (void)argc;
+    (void)argv;
+    fprintf(stderr, "Export requires the fd driver\n");
+    return 1;
+#endif
+}
+
 int main(int argc, char **argv)
 {
     bool listDrivers = false;
@@ -93,6 +143,12 @@ int main(int argc, char **argv)
         {"verbose",      no_argument,       0,'v'},
         {"driver",       required_argument, 0, OPT_DRIVER},
         {"list-drivers", no_argument,       0, OPT_LIST_DRIVERS},
+        {"size",         required_argument, 0, OPT_SIZE},
+        {"dpi",          required_argument, 0, OPT_DPI},
+        {"dump",         required_argument, 0, OPT_DUMP},
+        {"dump-format",  required_argument, 0, OPT_DUMP_FORMAT},
+        {"export",       required_argument, 0, OPT_EXPORT},
+        {"export-dir",   required_argument, 0, OPT_EXPORT_DIR},
         {0, 0, 0, 0}
     };
 
@@ -124,6 +180,31 @@ int main(int argc, char **argv)
             case OPT_LIST_DRIVERS:
                 listDrivers = true;
                 break;
+            case OPT_SIZE:
+                if (sscanf(optarg, "%ux%u", &opt.width, &opt.height) != 2 || !opt.width || !opt.height)
+                    usage("Size must be <width>x<height>");
+                break;
+            case OPT_DPI:
+                opt.dpi = atoi(optarg);
+                if (!opt.dpi)
+                    usage("Bad dpi");
+                break;
+            case OPT_DUMP:
+                opt.dumpDir = optarg;
+                break;
+            case OPT_DUMP_FORMAT:
+                if (strcmp(optarg, "png") != 0 && strcmp(optarg, "pgm") != 0)
+                    usage("Dump format must be png or pgm");
+                opt.dumpFormat = optarg;
+                break;
+            case OPT_EXPORT:
+                if (strcmp(optarg, "text") != 0 && strcmp(optarg, "ansi") != 0)
+                    usage("Export format must be text or ansi");
+                opt.exportFormat = optarg;
+                break;
+            case OPT_EXPORT_DIR:
+                opt.exportDir = optarg;
+                break;
             default:
                 usage("Unknown argument");
                 break;
@@ -132,6 +213,10 @@ int main(int argc, char **argv)
 
     initCrash();
     initLog();
+    if (opt.exportDir && !opt.exportFormat)
+        opt.exportFormat = "text";
+    if (opt.exportFormat)
+        return exportBooks(argc - optind, argv + optind);
     initDevice();
     initSettings();
 
@@ -0,0 +1,181 @@
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+#include "ocher/output/Blit.h"
+
+// Compositing is done on brightness (255 is white):  darken keeps the lower, and multiply is
+// a * b / 255, rounded.  Coverage is brightness inverted.
+
+static inline unsigned int mul255(unsigned int a, unsigned int b)
+{
+    unsigned int x = a * b + 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+static inline unsigned char blendPixel(unsigned char d, unsigned char s, FrameBuffer::Blend blend)
+{
+    switch (blend) {
+        case FrameBuffer::BlendCopy:
+            return s;
+        case FrameBuffer::BlendDarken:
+            return s < d ? s : d;
+        case FrameBuffer::BlendMultiply:
+        default:
+            return mul255(d, s);
+    }
+}
+
+#if defined(__SSE2__)
+static inline __m128i blend16(__m128i d, __m128i s, FrameBuffer::Blend blend)
+{
+    switch (blend) {
+        case FrameBuffer::BlendCopy:
+            return s;
+        case FrameBuffer::BlendDarken:
+            return _mm_min_epu8(d, s);
+        case FrameBuffer::BlendMultiply:
+        default: {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i half = _mm_set1_epi16(128);
+            __m128i lo = _mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(s, zero));
+            __m128i hi = _mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(s, zero));
+            lo = _mm_add_epi16(lo, half);
+            hi = _mm_add_epi16(hi, half);
+            lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+            hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+            return _mm_packus_epi16(lo, hi);
+        }
+    }
+}
+#elif defined(__ARM_NEON__)
+static inline uint8x16_t blend16(uint8x16_t d, uint8x16_t s, FrameBuffer::Blend blend)
+{
+    switch (blend) {
+        case FrameBuffer::BlendCopy:
+            return s;
+        case FrameBuffer::BlendDarken:
+            return vminq_u8(d, s);
+        case FrameBuffer::BlendMultiply:
+        default: {
+            uint16x8_t lo = vmull_u8(vget_low_u8(d), vget_low_u8(s));
+            uint16x8_t hi = vmull_u8(vget_high_u8(d), vget_high_u8(s));
+            return vcombine_u8(vrshrn_n_u16(vrsraq_n_u16(lo, lo, 8), 8),
+                    vrshrn_n_u16(vrsraq_n_u16(hi, hi, 8), 8));
+        }
+    }
+}
+#endif
+
+void blendRow(unsigned char *dst, const unsigned char *src, unsigned int n,
+        FrameBuffer::Blend blend, bool invert)
+{
+    unsigned int i = 0;
+#if defined(__SSE2__)
+    const __m128i ones = _mm_set1_epi8((char)0xff);
+    const __m128i dmask = invert ? _mm_setzero_si128() : ones;
+    for (; i + 16 <= n; i += 16) {
+        __m128i s = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(src + i)), ones);
+        __m128i d = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(dst + i)), dmask);
+        _mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(blend16(d, s, blend), dmask));
+    }
+#elif defined(__ARM_NEON__)
+    const uint8x16_t dmask = vdupq_n_u8(invert ? 0 : 0xff);
+    for (; i + 16 <= n; i += 16) {
+        uint8x16_t s = vmvnq_u8(vld1q_u8(src + i));
+        uint8x16_t d = veorq_u8(vld1q_u8(dst + i), dmask);
+        vst1q_u8(dst + i, veorq_u8(blend16(d, s, blend), dmask));
+    }
+#endif
+    const unsigned char dmask8 = invert ? 0 : 0xff;
+    for (; i < n; ++i) {
+        unsigned char d = dst[i] ^ dmask8;
+        dst[i] = blendPixel(d, ~src[i], blend) ^ dmask8;
+    }
+}
+
+Rect blendRect(unsigned char *pixels, unsigned int width, unsigned int height, unsigned int pitch,
+        const unsigned char *p, int x, int y, int w, int h, FrameBuffer::Blend blend, bool invert)
+{
+    // Clip to the surface; p keeps its pitch of w.
+    Rect r(x, y, w, h);
+    r.intersect(Rect(0, 0, width, height));
+    if (r.empty())
+        return r;
+    p += (r.y - y) * w + (r.x - x);
+
+    unsigned char *dst = pixels + r.y * pitch + r.x;
+    for (int j = 0; j < r.h; ++j) {
+        blendRow(dst, p, r.w, blend, invert);
+        p += w;
+        dst += pitch;
+    }
+    return r;
+}
+
+// 4x4 Bayer thresholds, 0..15.
+static const unsigned char bayer[4][4] = {
+    {  0,  8,  2, 10 },
+    { 12,  4, 14,  6 },
+    {  3, 11,  1,  9 },
+    { 15,  7, 13,  5 },
+};
+
+/**
+ * Quantizes coverage to 0..15.  0 and 255 are exact, so black and white stay black and white.
+ */
+static inline unsigned int dither4(unsigned int v, int x, int y)
+{
+    return (v * 15 + bayer[y & 3][x & 3] * 16 + 8) / 255;
+}
+
+static inline unsigned int blendPixel4(unsigned int d, unsigned int s, FrameBuffer::Blend blend)
+{
+    switch (blend) {
+        case FrameBuffer::BlendCopy:
+            return s;
+        case FrameBuffer::BlendDarken:
+            return s < d ? s : d;
+        case FrameBuffer::BlendMultiply:
+        default:
+            return (d * s + 7) / 15;
+    }
+}
+
+Rect blendRect4(unsigned char *pixels, unsigned int width, unsigned int height, unsigned int pitch,
+        const unsigned char *p, int x, int y, int w, int h, FrameBuffer::Blend blend, bool invert)
+{
+    Rect r(x, y, w, h);
+    r.intersect(Rect(0, 0, width, height));
+    if (r.empty())
+        return r;
+    p += (r.y - y) * w + (r.x - x);
+
+    const unsigned int dmask = invert ? 0 : 0xf;
+    for (int j = r.y; j < r.bottom(); ++j) {
+        unsigned char *row = pixels + j * pitch;
+        for (int i = r.x; i < r.right(); ++i) {
+            unsigned char *b = row + (i >> 1);
+            const unsigned int shift = (i & 1) ? 0 : 4;
+            unsigned int d = ((*b >> shift) & 0xf) ^ dmask;
+            unsigned int v = blendPixel4(d, 15 - dither4(p[i - r.x], i, j), blend) ^ dmask;
+            *b = (*b & ~(0xf << shift)) | (v << shift);
+        }
+        p += w;
+    }
+    return r;
+}
+
+Rect copyRect(unsigned char *pixels, unsigned int width, unsigned int height, unsigned int pitch,
+        unsigned int bpp, const unsigned char *p, int x, int y, int w, int h, bool invert)
+{
+    // Copying bytes, whatever they pack, is blending with BlendCopy.
+    const int shift = bpp == 4 ? 1 : 0;
+    Rect r = blendRect(pixels, width >> shift, height, pitch, p, x >> shift, y, w >> shift, h,
+            FrameBuffer::BlendCopy, invert);
+    r.x <<= shift;
+    r.w <<= shift;
+    return r;
+}
@@ -0,0 +1,42 @@
+#ifndef OCHER_BLIT_H
+#define OCHER_BLIT_H
+
+#include "ocher/output/DirtyRects.h"
+#include "ocher/output/FrameBuffer.h"
+
+
+/**
+ * Composites n pixels of coverage onto a row.  Vectorized where SSE2 or NEON is available.
+ * @param invert  dst holds brightness (255 is white) rather than coverage, so the coverage is
+ *      inverted on the fly.
+ */
+void blendRow(unsigned char *dst, const unsigned char *src, unsigned int n,
+        FrameBuffer::Blend blend, bool invert);
+
+/**
+ * Composites w x h coverage at (x, y) onto an 8-bit surface, clipped to the surface.
+ * @param pitch  Bytes per row of the surface.
+ * @return The part of the surface drawn on; empty if none.
+ */
+Rect blendRect(unsigned char *pixels, unsigned int width, unsigned int height, unsigned int pitch,
+        const unsigned char *p, int x, int y, int w, int h, FrameBuffer::Blend blend, bool invert);
+
+/**
+ * As blendRect, onto a surface of 4-bit pixels packed two per byte (the left pixel in the high
+ * nibble).  Coverage is quantized to 16 levels with an ordered dither, so that gradients do not
+ * band.  The dither depends only on the pixel's position, so a page composes identically on any
+ * surface of this format.
+ */
+Rect blendRect4(unsigned char *pixels, unsigned int width, unsigned int height, unsigned int pitch,
+        const unsigned char *p, int x, int y, int w, int h, FrameBuffer::Blend blend, bool invert);
+
+/**
+ * Copies w x h pixels already in the surface's format to (x, y), clipped.
+ * @param bpp  8, or 4 (in which case x and w must be even)
+ * @param invert  Invert while copying, between coverage and brightness.
+ * @return The part of the surface drawn on; empty if none.
+ */
+Rect copyRect(unsigned char *pixels, unsigned int width, unsigned int height, unsigned int pitch,
+        unsigned int bpp, const unsigned char *p, int x, int y, int w, int h, bool invert);
+
+#endif
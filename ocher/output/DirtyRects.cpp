@@ -0,0 +1,61 @@
+#include "ocher/output/DirtyRects.h"
+
+
+void Rect::unite(const Rect &r)
+{
+    if (r.empty())
+        return;
+    if (empty()) {
+        *this = r;
+        return;
+    }
+    int r2 = right() > r.right() ? right() : r.right();
+    int b2 = bottom() > r.bottom() ? bottom() : r.bottom();
+    if (r.x < x)
+        x = r.x;
+    if (r.y < y)
+        y = r.y;
+    w = r2 - x;
+    h = b2 - y;
+}
+
+void Rect::intersect(const Rect &r)
+{
+    int r2 = right() < r.right() ? right() : r.right();
+    int b2 = bottom() < r.bottom() ? bottom() : r.bottom();
+    if (r.x > x)
+        x = r.x;
+    if (r.y > y)
+        y = r.y;
+    w = r2 - x;
+    h = b2 - y;
+    if (empty())
+        w = h = 0;
+}
+
+void DirtyRects::add(const Rect &rect)
+{
+    if (rect.empty())
+        return;
+
+    Rect r = rect;
+    for (unsigned int i = 0; i < m_n; ) {
+        const Rect &d = m_rects[i];
+        if (r.x < d.right() + slop && d.x < r.right() + slop &&
+                r.y < d.bottom() + slop && d.y < r.bottom() + slop) {
+            // Absorb it, and recheck the rest against the grown rectangle.
+            r.unite(d);
+            m_rects[i] = m_rects[--m_n];
+            i = 0;
+        } else {
+            ++i;
+        }
+    }
+
+    if (m_n == maxRects) {
+        for (unsigned int i = 0; i < m_n; ++i)
+            r.unite(m_rects[i]);
+        m_n = 0;
+    }
+    m_rects[m_n++] = r;
+}
@@ -0,0 +1,56 @@
+#ifndef OCHER_DIRTYRECTS_H
+#define OCHER_DIRTYRECTS_H
+
+
+/**
+ * A rectangle, in pixels.
+ */
+struct Rect
+{
+    Rect() : x(0), y(0), w(0), h(0) {}
+    Rect(int _x, int _y, int _w, int _h) : x(_x), y(_y), w(_w), h(_h) {}
+
+    bool empty() const { return w <= 0 || h <= 0; }
+    int right() const { return x + w; }
+    int bottom() const { return y + h; }
+
+    /**
+     * Grows to the bounding box of both.
+     */
+    void unite(const Rect &r);
+    /**
+     * Shrinks to the overlap of both (possibly empty).
+     */
+    void intersect(const Rect &r);
+
+    int x;
+    int y;
+    int w;
+    int h;
+};
+
+/**
+ * Accumulates the damaged regions of a framebuffer between updates.  Rectangles that overlap or
+ * nearly touch are merged, and past a small number of rectangles all are merged into their
+ * bounding box, so that the display sees a few updates rather than one per glyph.
+ */
+class DirtyRects
+{
+public:
+    DirtyRects() : m_n(0) {}
+
+    void add(const Rect &r);
+    void clear() { m_n = 0; }
+
+    unsigned int size() const { return m_n; }
+    const Rect &operator[](unsigned int i) const { return m_rects[i]; }
+
+protected:
+    static const unsigned int maxRects = 16;
+    static const int slop = 16;  ///< merge rectangles closer than this many pixels
+
+    Rect m_rects[maxRects];
+    unsigned int m_n;
+};
+
+#endif
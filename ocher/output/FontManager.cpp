@@ -0,0 +1,143 @@
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "clc/crypto/MurmurHash2.h"
+#include "clc/support/Debug.h"
+#include "clc/support/Logger.h"
+
+#include "ocher/output/FontManager.h"
+
+
+FontManager::FontManager() :
+    m_lib(0)
+{
+}
+
+FontManager::~FontManager()
+{
+    clc::HashtableIter it(m_faces);
+    while (it.hasNext()) {
+        FontFace *f = (FontFace*)it.next();
+        clc::Log::warn("ocher.font", "%s still open", f->key.c_str());
+        if (f->face)
+            FT_Done_Face(f->face);
+        if (f->map)
+            munmap(f->map, f->mapLen);
+        delete f;
+    }
+    if (m_lib)
+        FT_Done_FreeType(m_lib);
+}
+
+bool FontManager::init()
+{
+    int r = FT_Init_FreeType(&m_lib);
+    if (r) {
+        clc::Log::error("ocher.font", "FT_Init_FreeType failed: %d", r);
+        m_lib = 0;
+        return false;
+    }
+    return true;
+}
+
+FontFace *FontManager::find(const clc::Buffer &key)
+{
+    FontFace *f = (FontFace*)m_faces.get(key.data(), key.size());
+    if (f)
+        f->refs++;
+    return f;
+}
+
+bool FontManager::openFace(FontFace *f, const void *base, size_t len)
+{
+    int r = FT_New_Memory_Face(m_lib, (const FT_Byte*)base, len, 0, &f->face);
+    if (r || ! f->face) {
+        clc::Log::error("ocher.font", "FT_New_Memory_Face %s failed: %d", f->key.c_str(), r);
+        f->face = 0;
+        return false;
+    }
+    f->refs = 1;
+    m_faces.put(f->key.data(), f->key.size(), f);
+    clc::Log::debug("ocher.font", "opened %s", f->key.c_str());
+    return true;
+}
+
+FontFace *FontManager::openFile(const char *path)
+{
+    clc::Locker locker(m_lock);
+    clc::Buffer key(path);
+    FontFace *f = find(key);
+    if (f)
+        return f;
+
+    int fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        clc::Log::warn("ocher.font", "%s: %s", path, strerror(errno));
+        return 0;
+    }
+    struct stat st;
+    void *map = MAP_FAILED;
+    if (fstat(fd, &st) == 0 && st.st_size > 0)
+        map = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (map == MAP_FAILED) {
+        clc::Log::error("ocher.font", "mmap %s: %s", path, strerror(errno));
+        return 0;
+    }
+
+    f = new FontFace;
+    f->key = key;
+    f->map = map;
+    f->mapLen = st.st_size;
+    if (! openFace(f, map, st.st_size)) {
+        munmap(map, st.st_size);
+        delete f;
+        return 0;
+    }
+    return f;
+}
+
+FontFace *FontManager::openMemory(clc::Buffer data)
+{
+    clc::Locker locker(m_lock);
+    // Keyed by content, so that the same font embedded in different books is shared.
+    char key[32];
+    sprintf(key, "mem:%08x:%u", clc::hash(data.data(), data.size()), (unsigned int)data.size());
+    FontFace *f = find(clc::Buffer(key));
+    if (f)
+        return f;
+
+    f = new FontFace;
+    f->key = key;
+    f->data = data;
+    if (! openFace(f, f->data.data(), f->data.size())) {
+        delete f;
+        return 0;
+    }
+    return f;
+}
+
+void FontManager::release(FontFace *f)
+{
+    if (! f)
+        return;
+    clc::Locker locker(m_lock);
+    ASSERT(f->refs > 0);
+    if (--f->refs == 0)
+        close(f);
+}
+
+void FontManager::close(FontFace *f)
+{
+    clc::Log::debug("ocher.font", "closed %s", f->key.c_str());
+    m_faces.remove(f->key.data(), f->key.size());
+    FT_Done_Face(f->face);
+    if (f->map)
+        munmap(f->map, f->mapLen);
+    delete f;
+}
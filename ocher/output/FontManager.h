@@ -0,0 +1,77 @@
+#ifndef OCHER_FONTMANAGER_H
+#define OCHER_FONTMANAGER_H
+
+#include <stddef.h>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "clc/data/Buffer.h"
+#include "clc/data/Hashtable.h"
+#include "clc/os/Lock.h"
+
+
+/**
+ * An open FreeType face, shared by everyone who opened the same font.  Obtained from and
+ * returned to a FontManager.
+ */
+class FontFace
+{
+public:
+    FT_Face face;
+
+protected:
+    friend class FontManager;
+
+    FontFace() : face(0), refs(0), map(0), mapLen(0) {}
+
+    unsigned int refs;
+    clc::Buffer key;
+    void *map;         ///< mapped font file, or 0
+    size_t mapLen;
+    clc::Buffer data;  ///< font held in memory (refcounted; never copied), if not mapped
+};
+
+/**
+ * Opens fonts as FreeType memory faces, without reading font files into the heap:  font files
+ * are mapped, and fonts already in memory (such as those unzipped from an epub) are used in
+ * place.  Faces are refcounted and shared, so a font opened twice (even by two books) is one
+ * face.  Thread-safe.
+ */
+class FontManager
+{
+public:
+    FontManager();
+    ~FontManager();
+
+    bool init();
+    FT_Library library() { return m_lib; }
+
+    /**
+     * @return The face, with a reference for the caller, or 0 on error.
+     */
+    FontFace *openFile(const char *path);
+
+    /**
+     * @param data  The font file's contents.  The face references (does not copy) the data, so
+     *      it must not be modified while the face is open.
+     * @return The face, with a reference for the caller, or 0 on error.
+     */
+    FontFace *openMemory(clc::Buffer data);
+
+    /**
+     * Drops the caller's reference; the face is closed once the last reference is dropped.
+     */
+    void release(FontFace *f);
+
+protected:
+    FontFace *find(const clc::Buffer &key);
+    bool openFace(FontFace *f, const void *base, size_t len);
+    void close(FontFace *f);
+
+    FT_Library m_lib;
+    clc::Lock m_lock;
+    clc::Hashtable m_faces;  ///< key -> FontFace*; entries are removed when closed
+};
+
+#endif
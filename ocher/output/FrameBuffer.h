@@ -5,15 +5,56 @@
 class FrameBuffer
 {
 public:
+    /**
+     * What an update shows, so that the display can choose how to refresh it.
+     */
+    enum Content {
+        ContentPage,  ///< a page of text:  best quality
+        ContentUi     ///< highlights and other quick feedback:  fastest
+    };
+
+    /**
+     * How blitted coverage combines with what is already drawn.
+     */
+    enum Blend {
+        BlendCopy,      ///< replace
+        BlendDarken,    ///< keep the heavier ink, so overlapping glyph edges do not erase
+        BlendMultiply   ///< inks accumulate
+    };
+
     FrameBuffer() {}
 
     virtual unsigned int height() = 0;
     virtual unsigned int width() = 0;
     virtual unsigned int dpi() = 0;
+    /**
+     * Bits per pixel of the framebuffer's own format:  8, or 4 with two pixels to a byte (the
+     * left pixel in the high nibble).
+     */
+    virtual unsigned int bpp() { return 8; }
 
     virtual void clear() = 0;
-    virtual void blit(unsigned char *p, int x, int y, int w, int h) = 0;
-    virtual int update(int x, int y, int w, int h, bool full) = 0;
+    /**
+     * Draws 8-bit coverage (0 is background, 255 is ink), clipped to the framebuffer.  The
+     * source is not modified.
+     * @param p  w x h pixels, w per row
+     */
+    virtual void blit(const unsigned char *p, int x, int y, int w, int h,
+            Blend blend = BlendDarken) = 0;
+    /**
+     * Copies coverage already at bpp() bits per pixel, such as a page prerendered into an
+     * FbMemory of the same depth.
+     * @param p  w x h pixels; at 4 bpp, x and w must be even
+     */
+    virtual void blitPacked(const unsigned char *p, int x, int y, int w, int h) {
+        blit(p, x, y, w, h, BlendCopy);
+    }
+    /**
+     * Shows what has been drawn within the region.
+     * @param full  Refresh the whole region even if unchanged (e.g. to clear e-ink ghosting).
+     * @return An update marker, for displays that update asynchronously.
+     */
+    virtual int update(int x, int y, int w, int h, bool full, Content content = ContentPage) = 0;
 };
 
 #endif
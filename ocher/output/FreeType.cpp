@@ -1,70 +1,255 @@
-#include <ctype.h>
+#include <string.h>
 
 #include "ocher/device/Device.h"
 #include "ocher/output/FreeType.h"
 #include "ocher/output/FrameBuffer.h"
 
+#include "clc/crypto/MurmurHash2.h"
 #include "clc/support/Logger.h"
 
 
+// Looked up in the current directory.
+static const char *systemFonts[] = {
+    "FreeSans.otf",
+    "FreeSansBold.otf",
+    "FreeSansOblique.otf",
+    "FreeSansBoldOblique.otf"
+};
+
 FreeType::FreeType(FrameBuffer *fb) :
+    m_style(Regular),
+    m_cur(&m_faces[Regular]),
+    m_face(0),
+    m_points(12),
+    m_generation(1),
+    m_nextConfig(0),
+    m_glyphs(0),
     m_fb(fb)
 {
+    for (int i = 0; i < Styles; ++i)
+        m_styles[i] = 0;
+}
+
+FreeType::~FreeType()
+{
+    closeFaces();
 }
 
 bool FreeType::init()
 {
-    int r;
-    r = FT_Init_FreeType(&m_lib);
-    if (r) {
-        clc::Log::error("ocher.freetype", "FT_Init_FreeType failed: %d", r);
+    if (! m_fonts.init())
+        return false;
+    if (! open(Regular))
         return false;
+    select(Regular);
+    return true;
+}
+
+void FreeType::closeFaces()
+{
+    for (int i = 0; i < Styles; ++i) {
+        m_fonts.release(m_faces[i].font);
+        m_faces[i].font = 0;
+        delete[] m_faces[i].advances;
+        m_faces[i].advances = 0;
+        m_styles[i] = 0;
     }
+}
 
-    r = FT_New_Face(m_lib, "FreeSans.otf", 0, &m_face);
-    if (r || !m_face) {
-        clc::Log::error("ocher.freetype", "FT_New_Face failed: %d", r);
-        return false;
+FreeType::Face *FreeType::open(int style)
+{
+    if (m_styles[style])
+        return m_styles[style];
+
+    FontFace *font = 0;
+    const int bold = (style & Bold) ? 1 : 0;
+    const int italic = (style & Italic) ? 1 : 0;
+    for (std::list<EmbeddedFont>::const_iterator it = m_bookFonts.begin(); it != m_bookFonts.end(); ++it) {
+        if (it->bold == bold && it->italic == italic) {
+            font = m_fonts.openMemory(it->data);
+            if (font)
+                clc::Log::info("ocher.freetype", "using embedded font %s", it->name.c_str());
+            break;
+        }
     }
-    return true;
+    if (! font && style != Regular && ! m_bookFonts.empty()) {
+        // Keep to the book's typeface rather than mixing in a system variant.
+        return m_styles[style] = open(Regular);
+    }
+    if (! font)
+        font = m_fonts.openFile(systemFonts[style]);
+    if (! font) {
+        if (style == Regular)
+            return 0;
+        return m_styles[style] = open(Regular);
+    }
+
+    Face *f = &m_faces[style];
+    f->font = font;
+    f->generation = 0;
+    f->advances = new int16_t[font->face->num_glyphs];
+    return m_styles[style] = f;
+}
+
+void FreeType::resetMetrics(Face *f)
+{
+    for (unsigned int i = 0; i < latinLimit; ++i)
+        f->latinAdvance[i] = unknownAdvance;
+    for (long i = 0; i < f->font->face->num_glyphs; ++i)
+        f->advances[i] = unknownAdvance;
+}
+
+void FreeType::select(int style)
+{
+    Face *f = open(style);
+    if (! f)
+        return;
+    if (f->generation != m_generation) {
+        FT_Set_Char_Size(f->font->face, 0, m_points*64, m_fb->dpi(), m_fb->dpi());
+        f->generation = m_generation;
+        f->config = ++m_nextConfig;
+        resetMetrics(f);
+    }
+    m_style = style;
+    m_cur = f;
+    m_face = f->font->face;
 }
 
 void FreeType::setSize(unsigned int points)
 {
-    FT_Set_Char_Size(m_face, 0, points*64, m_fb->dpi(), m_fb->dpi());
+    m_points = points;
+    ++m_generation;
+    select(m_style);
 }
 
-// TODO:  how slow is this?  Might be worth caching rendered words (per
-// face/size)
-bool FreeType::renderGlyph(int c, bool doBlit, int penX, int penY, int *dx, int *dy, int *height)
+void FreeType::setStyle(bool bold, bool italic)
 {
-    FT_GlyphSlot slot = m_face->glyph;
-    unsigned int glyphIndex = FT_Get_Char_Index(m_face, c);
-    int r = FT_Load_Glyph(m_face, glyphIndex, FT_LOAD_DEFAULT);
+    select((bold ? Bold : 0) | (italic ? Italic : 0));
+}
+
+void FreeType::fontKey(clc::Buffer &key) const
+{
+    for (std::list<EmbeddedFont>::const_iterator it = m_bookFonts.begin(); it != m_bookFonts.end(); ++it) {
+        key.appendFormat("font %d%d %08x:%u\n", it->bold, it->italic,
+                clc::hash(it->data.data(), it->data.size()), (unsigned int)it->data.size());
+    }
+    for (int i = 0; i < Styles; ++i)
+        key.appendFormat("font %s\n", systemFonts[i]);
+}
+
+bool FreeType::setBookFonts(const std::list<EmbeddedFont> &fonts)
+{
+    if (! m_fonts.library()) {
+        // Nothing open yet; init opens them.
+        m_bookFonts = fonts;
+        ++m_generation;
+        return true;
+    }
+
+    // Open the new regular face before dropping the old faces, so that fonts the books have in
+    // common (such as the system fonts) stay open, and the old faces stay in use on failure.
+    Face old[Styles];
+    Face *oldStyles[Styles];
+    for (int i = 0; i < Styles; ++i) {
+        old[i] = m_faces[i];
+        m_faces[i] = Face();
+        oldStyles[i] = m_styles[i];
+        m_styles[i] = 0;
+    }
+    std::list<EmbeddedFont> oldFonts;
+    oldFonts.swap(m_bookFonts);
+    m_bookFonts = fonts;
+    if (! open(Regular)) {
+        clc::Log::error("ocher.freetype", "no regular face; keeping the fonts in use");
+        for (int i = 0; i < Styles; ++i) {
+            m_faces[i] = old[i];
+            m_styles[i] = oldStyles[i];
+        }
+        m_bookFonts.swap(oldFonts);
+        return false;
+    }
+
+    ++m_generation;
+    select(Regular);
+    for (int i = 0; i < Styles; ++i) {
+        m_fonts.release(old[i].font);
+        delete[] old[i].advances;
+    }
+    return true;
+}
+
+bool FreeType::glyphAdvance(unsigned int glyphIndex, int *dx)
+{
+    int16_t *advances = m_cur->advances;
+    if (glyphIndex < (unsigned long)m_face->num_glyphs && advances[glyphIndex] != unknownAdvance) {
+        *dx = advances[glyphIndex];
+        return true;
+    }
+
+    // Hinted, to match what renderGlyph draws, but metrics only.  (This is FT_Get_Advance's
+    // hinted path; called directly since that rescales the already scaled advance.)
+    int r = FT_Load_Glyph(m_face, glyphIndex, FT_LOAD_DEFAULT | FT_LOAD_NO_BITMAP | FT_LOAD_ADVANCE_ONLY);
     if (r) {
         clc::Log::error("ocher.freetype", "FT_Load_Glyph failed: %d", r);
         return false;
     }
-    if (m_face->glyph->format != FT_GLYPH_FORMAT_BITMAP) {
-        r = FT_Render_Glyph(m_face->glyph, FT_RENDER_MODE_NORMAL);
+    *dx = m_face->glyph->advance.x >> 6;
+    if (glyphIndex < (unsigned long)m_face->num_glyphs)
+        advances[glyphIndex] = *dx;
+    return true;
+}
+
+bool FreeType::measure(uint32_t c, unsigned int *glyphIndex, int *dx)
+{
+    if (c < latinLimit) {
+        Face *f = m_cur;
+        if (f->latinAdvance[c] == unknownAdvance) {
+            unsigned int glyph = charIndex(c);
+            int advance;
+            if (! glyphAdvance(glyph, &advance))
+                return false;
+            f->latinGlyph[c] = glyph;
+            f->latinAdvance[c] = advance;
+        }
+        *glyphIndex = f->latinGlyph[c];
+        *dx = f->latinAdvance[c];
+        return true;
+    }
+    *glyphIndex = charIndex(c);
+    return glyphAdvance(*glyphIndex, dx);
+}
+
+bool FreeType::renderGlyph(unsigned int glyphIndex, int penX, int penY)
+{
+    GlyphCache::Glyph *g = m_cache.get(m_cur->config, glyphIndex, 0);
+    if (! g) {
+        int r = FT_Load_Glyph(m_face, glyphIndex, FT_LOAD_DEFAULT);
         if (r) {
-            clc::Log::error("ocher.freetype", "FT_Render_Glyph failed: %d", r);
+            clc::Log::error("ocher.freetype", "FT_Load_Glyph failed: %d", r);
             return false;
         }
-    }
+        FT_GlyphSlot slot = m_face->glyph;
+        if (slot->format != FT_GLYPH_FORMAT_BITMAP) {
+            r = FT_Render_Glyph(slot, FT_RENDER_MODE_NORMAL);
+            if (r) {
+                clc::Log::error("ocher.freetype", "FT_Render_Glyph failed: %d", r);
+                return false;
+            }
+        }
 
-    if (doBlit) {
-        //printf("%u(%c) %d %d %d %d\n", c, isprint(c) ? c : '?',
-        //        m_face->glyph->bitmap_left, m_face->glyph->bitmap_top,
-        //        m_face->glyph->bitmap.width, m_face->glyph->bitmap.rows);
-        m_fb->blit(m_face->glyph->bitmap.buffer, penX + m_face->glyph->bitmap_left,
-                penY - m_face->glyph->bitmap_top, m_face->glyph->bitmap.width,
-                m_face->glyph->bitmap.rows);
+        GlyphCache::Glyph tmpl;
+        memset(&tmpl, 0, sizeof(tmpl));
+        tmpl.config = m_cur->config;
+        tmpl.index = glyphIndex;
+        tmpl.bitmapLeft = slot->bitmap_left;
+        tmpl.bitmapTop = slot->bitmap_top;
+        tmpl.width = slot->bitmap.width;
+        tmpl.height = slot->bitmap.rows;
+        tmpl.advance = slot->advance.x >> 6;
+        g = m_cache.put(tmpl, slot->bitmap.buffer, slot->bitmap.pitch);
     }
 
-    *dx = slot->advance.x >> 6;
-    *dy = slot->advance.y >> 6;
-    *height = m_face->size->metrics.height >> 6;
+    m_fb->blit(g->bitmap(), penX + g->bitmapLeft, penY - g->bitmapTop, g->width, g->height);
+    ++m_glyphs;
     return true;
 }
-
@@ -1,26 +1,128 @@
 #ifndef OCHER_FREETYPE_H
 #define OCHER_FREETYPE_H
 
+#include <stdint.h>
+#include <list>
+
 #include <ft2build.h>
 #include FT_FREETYPE_H
 
+#include "ocher/fmt/Format.h"
+#include "ocher/output/FontManager.h"
+#include "ocher/output/GlyphCache.h"
+
 class FrameBuffer;
 
 class FreeType
 {
 public:
     FreeType(FrameBuffer *fb);
+    ~FreeType();
 
+    /**
+     * Opens the regular face.  Other styles are opened when first selected.
+     */
     bool init();
     void setSize(unsigned int points);
-    bool renderGlyph(int c, bool doBlit, int penX, int penY, int *dx, int *dy, int *height);
+    unsigned int points() const { return m_points; }
+
+    /**
+     * Where renderGlyph draws.  Must have the same dpi.
+     */
+    void setFrameBuffer(FrameBuffer *fb) { m_fb = fb; }
+
+    /**
+     * Selects the face for the style, opening it on first use.  A style with no font of its
+     * own uses the regular face.
+     */
+    void setStyle(bool bold, bool italic);
+
+    /**
+     * Fonts supplied by the book, which take precedence over the system fonts.  Empty when the
+     * book has none.  The regular style is selected.
+     * @return false if the regular face could not be opened, in which case the fonts are
+     *      unchanged
+     */
+    bool setBookFonts(const std::list<EmbeddedFont> &fonts);
+    const std::list<EmbeddedFont> &bookFonts() const { return m_bookFonts; }
+
+    /**
+     * Identifies the current face and size.  Changes whenever either does; glyph indices and
+     * advances are only valid for the configuration they were computed under.
+     */
+    unsigned int config() const { return m_cur->config; }
+
+    /**
+     * Changes whenever the size or fonts change, invalidating every configuration.
+     */
+    unsigned int generation() const { return m_generation; }
+
+    /**
+     * Appends a description of the fonts in use (not the size), such that different fonts
+     * describe differently.
+     */
+    void fontKey(clc::Buffer &key) const;
+
+    unsigned int charIndex(uint32_t c) { return FT_Get_Char_Index(m_face, c); }
+    /**
+     * Measures a glyph without loading its bitmap or rasterizing it.  Advances are remembered
+     * in a dense table per configuration.
+     * @param dx  Set to the horizontal advance of the glyph, in pixels.
+     */
+    bool glyphAdvance(unsigned int glyphIndex, int *dx);
+    /**
+     * Glyph index and advance of a codepoint, for measuring.  Latin codepoints are answered
+     * from a dense table per configuration, skipping the cmap.
+     */
+    bool measure(uint32_t c, unsigned int *glyphIndex, int *dx);
+    /**
+     * Draws a glyph, rasterizing it only if it is not in the glyph cache.
+     */
+    bool renderGlyph(unsigned int glyphIndex, int penX, int penY);
+    /**
+     * @return Glyphs drawn so far, for benchmarking.
+     */
+    unsigned long glyphsRendered() const { return m_glyphs; }
+    int lineHeight() const { return m_face->size->metrics.height >> 6; }
 
 protected:
-    FT_Library m_lib;
-    FT_Face m_face;
+    static const int16_t unknownAdvance = -32768;
+    static const unsigned int latinLimit = 0x250;  ///< Basic Latin through Latin Extended-B
+
+    enum { Regular = 0, Bold = 1, Italic = 2, BoldItalic = 3, Styles = 4 };
+
+    /**
+     * One opened style, with its metrics at the current size.
+     */
+    struct Face {
+        Face() : font(0), generation(0), config(0), advances(0) {}
+        FontFace *font;
+        unsigned int generation;  ///< m_generation when last sized
+        unsigned int config;
+        int16_t *advances;  ///< by glyph index; font->face->num_glyphs entries
+        uint16_t latinGlyph[latinLimit];
+        int16_t latinAdvance[latinLimit];
+    };
+
+    Face *open(int style);
+    void select(int style);
+    void closeFaces();
+    static void resetMetrics(Face *f);
+
+    FontManager m_fonts;
+    std::list<EmbeddedFont> m_bookFonts;
+    Face m_faces[Styles];
+    Face *m_styles[Styles];  ///< 0 until opened; may point at the regular Face
+    int m_style;
+    Face *m_cur;
+    FT_Face m_face;  ///< m_cur's
+    unsigned int m_points;
+    unsigned int m_generation;
+    unsigned int m_nextConfig;
+    GlyphCache m_cache;
+    unsigned long m_glyphs;
 
     FrameBuffer *m_fb;
 };
 
 #endif
-
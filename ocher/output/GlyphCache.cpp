@@ -0,0 +1,121 @@
+#include <string.h>
+
+#include "clc/support/Debug.h"
+#include "clc/support/Logger.h"
+
+#include "ocher/output/GlyphCache.h"
+
+
+GlyphCache::GlyphCache(unsigned int budget) :
+    m_budget(budget),
+    m_bytes(0),
+    m_tick(0),
+    m_hits(0),
+    m_misses(0),
+    m_glyphs(1024)
+{
+}
+
+GlyphCache::~GlyphCache()
+{
+    clear();
+}
+
+void GlyphCache::makeKey(Key *key, uint32_t config, unsigned int index, unsigned int style)
+{
+    memset(key, 0, sizeof(*key));
+    key->config = config;
+    key->index = index;
+    key->style = style;
+}
+
+GlyphCache::Glyph *GlyphCache::get(uint32_t config, unsigned int index, unsigned int style)
+{
+    Key key;
+    makeKey(&key, config, index, style);
+    Glyph *g = (Glyph*)m_glyphs.get(&key, sizeof(key));
+    if (g) {
+        m_hits++;
+        ((Slab*)g->slab)->lastUse = ++m_tick;
+    } else {
+        m_misses++;
+    }
+    return g;
+}
+
+GlyphCache::Glyph *GlyphCache::put(const Glyph &tmpl, const unsigned char *bitmap, int pitch)
+{
+    const unsigned int bitmapBytes = tmpl.width * tmpl.height;
+    const unsigned int size = (sizeof(Glyph) + bitmapBytes + sizeof(void*)-1) & ~(sizeof(void*)-1);
+
+    Glyph *g = alloc(size);
+    void *slab = g->slab;
+    *g = tmpl;
+    g->size = size;
+    g->slab = slab;
+    unsigned char *dst = g->bitmap();
+    for (unsigned int y = 0; y < tmpl.height; ++y) {
+        memcpy(dst, bitmap, tmpl.width);
+        dst += tmpl.width;
+        bitmap += pitch;
+    }
+
+    Key key;
+    makeKey(&key, g->config, g->index, g->style);
+    m_glyphs.put(&key, sizeof(key), g);
+    return g;
+}
+
+GlyphCache::Glyph *GlyphCache::alloc(unsigned int size)
+{
+    Slab *slab = m_slabs.size() ? (Slab*)m_slabs.lastItem() : 0;
+    if (!slab || slab->used + size > slab->size) {
+        unsigned int n = size > slabSize ? size : slabSize;
+        while (m_slabs.size() && m_bytes + n > m_budget)
+            evict();
+        slab = new Slab;
+        slab->size = n;
+        slab->used = 0;
+        slab->data = new unsigned char[n];
+        m_slabs.add(slab);
+        m_bytes += n;
+    }
+    slab->lastUse = ++m_tick;
+    Glyph *g = (Glyph*)(slab->data + slab->used);
+    slab->used += size;
+    g->slab = slab;
+    return g;
+}
+
+void GlyphCache::evict()
+{
+    unsigned int victim = 0;
+    for (unsigned int i = 1; i < m_slabs.size(); ++i) {
+        if (((Slab*)m_slabs.ItemAtFast(i))->lastUse < ((Slab*)m_slabs.ItemAtFast(victim))->lastUse)
+            victim = i;
+    }
+    Slab *slab = (Slab*)m_slabs.RemoveItem(victim);
+    clc::Log::trace("ocher.glyphcache", "evicting slab of %u bytes", slab->used);
+    freeSlab(slab);
+}
+
+void GlyphCache::freeSlab(Slab *slab)
+{
+    for (unsigned int off = 0; off < slab->used; ) {
+        Glyph *g = (Glyph*)(slab->data + off);
+        Key key;
+        makeKey(&key, g->config, g->index, g->style);
+        m_glyphs.remove(&key, sizeof(key));
+        off += g->size;
+    }
+    m_bytes -= slab->size;
+    delete[] slab->data;
+    delete slab;
+}
+
+void GlyphCache::clear()
+{
+    while (m_slabs.size()) {
+        freeSlab((Slab*)m_slabs.remove());
+    }
+}
@@ -0,0 +1,94 @@
+#ifndef OCHER_GLYPHCACHE_H
+#define OCHER_GLYPHCACHE_H
+
+#include <stdint.h>
+
+#include "clc/data/Hashtable.h"
+#include "clc/data/List.h"
+
+
+/**
+ * Cache of rendered glyph bitmaps, keyed by (font configuration, glyph index, style).
+ *
+ * Each glyph is stored as a Glyph record (bearings, size, advance) immediately followed by its
+ * bitmap, packed into fixed-size slabs.  Eviction is LRU at slab granularity:  when a new slab
+ * would exceed the byte budget, the least recently used slab is dropped with all of its glyphs.
+ */
+class GlyphCache
+{
+public:
+    struct Glyph {
+        uint32_t config;  ///< FreeType::config() the glyph was rendered under
+        uint16_t index;   ///< glyph index within the face
+        uint8_t style;    ///< render style (future:  synthetic bold, ...)
+        uint8_t pad0;
+        int16_t bitmapLeft;
+        int16_t bitmapTop;
+        uint16_t width;   ///< bitmap width; the bitmap is packed (pitch == width)
+        uint16_t height;
+        int16_t advance;  ///< horizontal advance, pixels
+        uint16_t pad1;
+        uint32_t size;    ///< bytes of record plus bitmap, rounded for alignment
+        void *slab;       ///< owning Slab
+
+        unsigned char *bitmap() { return (unsigned char*)(this+1); }
+    };
+
+    /**
+     * @param budget  Bytes of slab memory to keep.  At least one slab is always kept.
+     */
+    GlyphCache(unsigned int budget = 1024*1024);
+    ~GlyphCache();
+
+    /**
+     * @return The cached glyph, or 0 on a miss.
+     */
+    Glyph *get(uint32_t config, unsigned int index, unsigned int style);
+
+    /**
+     * Copies a rendered glyph into the cache.
+     * @param g  config, index, style, bearings, width, height and advance are used.
+     * @param bitmap  Rows of g.height, pitch bytes apart.
+     * @return The cached copy.
+     */
+    Glyph *put(const Glyph &g, const unsigned char *bitmap, int pitch);
+
+    void clear();
+
+    unsigned int hits() const { return m_hits; }
+    unsigned int misses() const { return m_misses; }
+    unsigned int bytes() const { return m_bytes; }
+
+protected:
+    struct Slab {
+        unsigned int size;
+        unsigned int used;
+        unsigned int lastUse;
+        unsigned char *data;
+    };
+
+    struct Key {
+        uint32_t config;
+        uint16_t index;
+        uint8_t style;
+        uint8_t pad;
+    };
+
+    static void makeKey(Key *key, uint32_t config, unsigned int index, unsigned int style);
+
+    Glyph *alloc(unsigned int size);
+    void evict();
+    void freeSlab(Slab *slab);
+
+    static const unsigned int slabSize = 16*1024;
+
+    unsigned int m_budget;
+    unsigned int m_bytes;
+    unsigned int m_tick;
+    unsigned int m_hits;
+    unsigned int m_misses;
+    clc::List m_slabs;        ///< Slab*, oldest first; the last one is being filled
+    clc::Hashtable m_glyphs;  ///< Key -> Glyph* (owned by the slabs)
+};
+
+#endif
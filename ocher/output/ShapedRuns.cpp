@@ -0,0 +1,106 @@
+#include <string.h>
+
+#include "clc/support/Logger.h"
+
+#include "ocher/output/FreeType.h"
+#include "ocher/output/ShapedRuns.h"
+
+
+ShapedRuns::ShapedRuns(FreeType *ft) :
+    m_ft(ft),
+    m_generation(0),
+    m_bytes(0)
+{
+}
+
+const ShapedGlyph *ShapedRuns::get(const clc::Buffer *str)
+{
+    if (m_generation != m_ft->generation()) {
+        clear();
+        m_generation = m_ft->generation();
+    }
+    Key key;
+    memset(&key, 0, sizeof(key));
+    key.str = str;
+    key.config = m_ft->config();
+    ShapedGlyph *run = (ShapedGlyph*)m_runs.get(&key, sizeof(key));
+    if (! run) {
+        run = build(str);
+        m_runs.put(&key, sizeof(key), run);
+        m_bytes += (str->size() ? str->size() : 1) * sizeof(ShapedGlyph);
+    }
+    return run;
+}
+
+void ShapedRuns::trim()
+{
+    if (m_bytes > maxBytes) {
+        clc::Log::debug("ocher.shape", "dropping %u bytes of runs", m_bytes);
+        clear();
+    }
+}
+
+unsigned int ShapedRuns::glyphOffset(const clc::Buffer *str, unsigned int strOffset)
+{
+    const unsigned char *p = (const unsigned char*)str->data();
+    const unsigned char *end = p + str->size();
+    const unsigned char *stop = p + strOffset;
+    unsigned int i = 0;
+    while (p < stop) {
+        unsigned int n = utf8Len(p, end-p);
+        if (n) {
+            p += n;
+            ++i;
+        } else {
+            ++p;
+        }
+    }
+    return i;
+}
+
+ShapedGlyph *ShapedRuns::build(const clc::Buffer *str)
+{
+    const unsigned int len = str->size();
+    const unsigned char *p = (const unsigned char*)str->data();
+    const unsigned char *end = p + len;
+
+    // Never more codepoints than bytes.
+    ShapedGlyph *run = new ShapedGlyph[len ? len : 1];
+    ShapedGlyph *g = run;
+    while (p < end) {
+        uint32_t c = *p;
+        unsigned int n = utf8Len(p, end-p);
+        if (! n) {
+            // out of sync?
+            ++p;
+            continue;
+        }
+        // Convert UTF8 to UTF32, as required by FreeType
+        switch (n) {
+            case 2:
+                c = ((c & 0x1f) << 6) | (p[1] & 0x3f);
+                break;
+            case 3:
+                c = ((c & 0x0f) << 12) | ((p[1] & 0x3f) << 6) | (p[2] & 0x3f);
+                break;
+            case 4:
+                c = ((c & 0x07) << 18) | ((p[1] & 0x3f) << 12) | ((p[2] & 0x3f) << 6) | (p[3] & 0x3f);
+                break;
+            case 5:
+                c = ((c & 0x03) << 24) | ((p[1] & 0x3f) << 18) | ((p[2] & 0x3f) << 12) | ((p[3] & 0x3f) << 6) | (p[4] & 0x3f);
+                break;
+            case 6:
+                c = ((c & 0x01) << 30) | ((p[1] & 0x3f) << 24) | ((p[2] & 0x3f) << 18) | ((p[3] & 0x3f) << 12) | ((p[4] & 0x3f) << 6) | (p[5] & 0x3f);
+                break;
+        }
+        p += n;
+
+        unsigned int glyph = 0;
+        int dx = 0;
+        m_ft->measure(c, &glyph, &dx);
+        g->glyph = glyph;
+        g->advance = dx;
+        ++g;
+    }
+    return run;
+}
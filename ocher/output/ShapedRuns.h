@@ -0,0 +1,102 @@
+#ifndef OCHER_SHAPEDRUNS_H
+#define OCHER_SHAPEDRUNS_H
+
+#include <stdint.h>
+
+#include "clc/data/Buffer.h"
+#include "clc/data/Hashtable.h"
+
+class FreeType;
+
+
+/**
+ * Glyph index and advance of one codepoint, for one face and size.
+ */
+struct ShapedGlyph
+{
+    uint16_t glyph;
+    int16_t advance;  ///< horizontal advance, pixels
+};
+
+/**
+ * Side table of shaped runs for the strings of a layout.  A run holds one ShapedGlyph per
+ * codepoint of its string, so that pagination and drawing need neither decode UTF-8 nor consult
+ * the cmap more than once per font configuration.  Runs are built on first use, keyed by the
+ * string (the layout's strings are immutable) and FreeType::config(), and are dropped whenever
+ * FreeType::generation() changes, or by trim once they outgrow maxBytes.
+ *
+ * Codepoints are stepped with utf8Len; a byte for which it returns 0 is skipped and has no
+ * entry.
+ */
+class ShapedRuns
+{
+public:
+    ShapedRuns(FreeType *ft);
+
+    /**
+     * @return The run for the string in the current configuration, building it if needed.
+     */
+    const ShapedGlyph *get(const clc::Buffer *str);
+
+    /**
+     * Drops all runs, for example because the layout changed.
+     */
+    void clear() { m_runs.clear(); m_bytes = 0; }
+
+    /**
+     * Drops all runs if they hold more than maxBytes.  Runs returned by get must no longer be in
+     * use, so call between pages.
+     */
+    void trim();
+
+    /**
+     * @param avail  Bytes remaining in the string, starting at p.
+     * @return Length of the UTF-8 sequence starting at p, or 0 if p does not start a sequence
+     *      (or the sequence is truncated).
+     */
+    static unsigned int utf8Len(const unsigned char *p, unsigned int avail) {
+        unsigned int n;
+        if (*p < 0x80) n = 1;
+        else if ((*p & 0xe0) == 0xc0) n = 2;
+        else if ((*p & 0xf0) == 0xe0) n = 3;
+        else if ((*p & 0xf8) == 0xf0) n = 4;
+        else if ((*p & 0xfc) == 0xf8) n = 5;
+        else if ((*p & 0xfe) == 0xfc) n = 6;
+        else n = 0;
+        return n <= avail ? n : 0;
+    }
+
+    /**
+     * @return Index of the run entry for the codepoint starting at byte offset strOffset.
+     */
+    static unsigned int glyphOffset(const clc::Buffer *str, unsigned int strOffset);
+
+protected:
+    struct Key {
+        const clc::Buffer *str;
+        unsigned int config;
+    };
+
+    class RunTable : public clc::Hashtable
+    {
+    public:
+        RunTable() : clc::Hashtable(1024) {}
+        ~RunTable() { clear(); }
+    protected:
+        void deleteValue(void *value) const { delete[] (ShapedGlyph*)value; }
+    };
+
+    /**
+     * Runs are cheap to rebuild, and a page needs few; bound the memory rather than track use.
+     */
+    static const unsigned int maxBytes = 1024*1024;
+
+    ShapedGlyph *build(const clc::Buffer *str);
+
+    FreeType *m_ft;
+    unsigned int m_generation;
+    unsigned int m_bytes;  ///< held by m_runs
+    RunTable m_runs;
+};
+
+#endif
@@ -0,0 +1,146 @@
+#include <errno.h>
+#include <string.h>
+#include <zlib.h>
+
+#include "clc/support/Logger.h"
+
+#include "ocher/output/Blit.h"
+#include "ocher/output/memory/FbMemory.h"
+
+
+FbMemory::FbMemory(unsigned int width, unsigned int height, unsigned int dpi, unsigned int bpp) :
+    m_width(width),
+    m_height(height),
+    m_dpi(dpi),
+    m_bpp(bpp == 4 ? 4 : 8),
+    m_pitch(m_bpp == 4 ? (width + 1) / 2 : width),
+    m_pixels(new unsigned char[m_pitch * height])
+{
+    clear();
+}
+
+FbMemory::~FbMemory()
+{
+    delete[] m_pixels;
+}
+
+void FbMemory::resize(unsigned int width, unsigned int height, unsigned int dpi)
+{
+    delete[] m_pixels;
+    m_width = width;
+    m_height = height;
+    m_dpi = dpi;
+    m_pitch = m_bpp == 4 ? (width + 1) / 2 : width;
+    m_pixels = new unsigned char[m_pitch * height];
+    clear();
+}
+
+void FbMemory::clear()
+{
+    memset(m_pixels, 0, m_pitch * m_height);
+}
+
+void FbMemory::blit(const unsigned char *p, int x, int y, int w, int h, Blend blend)
+{
+    if (m_bpp == 4)
+        blendRect4(m_pixels, m_width, m_height, m_pitch, p, x, y, w, h, blend, false);
+    else
+        blendRect(m_pixels, m_width, m_height, m_pitch, p, x, y, w, h, blend, false);
+}
+
+void FbMemory::blitPacked(const unsigned char *p, int x, int y, int w, int h)
+{
+    copyRect(m_pixels, m_width, m_height, m_pitch, m_bpp, p, x, y, w, h, false);
+}
+
+void FbMemory::grayRow(unsigned int y, unsigned char *out) const
+{
+    const unsigned char *row = m_pixels + y * m_pitch;
+    for (unsigned int x = 0; x < m_width; ++x) {
+        if (m_bpp == 4)
+            out[x] = 255 - ((x & 1) ? row[x >> 1] & 0xf : row[x >> 1] >> 4) * 17;
+        else
+            out[x] = 255 - row[x];
+    }
+}
+
+bool FbMemory::save(const char *path)
+{
+    FILE *f = fopen(path, "wb");
+    if (! f) {
+        clc::Log::error("ocher.memory", "%s: %s", path, strerror(errno));
+        return false;
+    }
+    size_t len = strlen(path);
+    bool ok = (len > 4 && strcmp(path + len - 4, ".png") == 0) ? savePng(f) : savePgm(f);
+    if (fclose(f) != 0)
+        ok = false;
+    if (! ok)
+        clc::Log::error("ocher.memory", "%s: failed to write", path);
+    return ok;
+}
+
+bool FbMemory::savePgm(FILE *f)
+{
+    fprintf(f, "P5\n%u %u\n255\n", m_width, m_height);
+    unsigned char *row = new unsigned char[m_width];
+    bool ok = true;
+    for (unsigned int y = 0; y < m_height && ok; ++y) {
+        grayRow(y, row);
+        ok = fwrite(row, 1, m_width, f) == m_width;
+    }
+    delete[] row;
+    return ok;
+}
+
+static void put32(unsigned char *p, uint32_t v)
+{
+    p[0] = v >> 24;
+    p[1] = v >> 16;
+    p[2] = v >> 8;
+    p[3] = v;
+}
+
+static bool pngChunk(FILE *f, const char *type, const unsigned char *data, uint32_t len)
+{
+    unsigned char be[4];
+    put32(be, len);
+    uLong crc = crc32(crc32(0, (const Bytef*)type, 4), data, len);
+    bool ok = fwrite(be, 1, 4, f) == 4 && fwrite(type, 1, 4, f) == 4 &&
+        fwrite(data, 1, len, f) == len;
+    put32(be, crc);
+    return ok && fwrite(be, 1, 4, f) == 4;
+}
+
+bool FbMemory::savePng(FILE *f)
+{
+    // Each row is prefixed by its filter type (0, none).
+    const uLong rawLen = (m_width + 1) * m_height;
+    unsigned char *raw = new unsigned char[rawLen];
+    for (unsigned int y = 0; y < m_height; ++y) {
+        raw[y * (m_width + 1)] = 0;
+        grayRow(y, raw + y * (m_width + 1) + 1);
+    }
+    uLongf zLen = compressBound(rawLen);
+    unsigned char *z = new unsigned char[zLen];
+    bool ok = compress2(z, &zLen, raw, rawLen, Z_BEST_SPEED) == Z_OK;
+    delete[] raw;
+
+    if (ok) {
+        static const unsigned char signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n' };
+        unsigned char ihdr[13];
+        put32(ihdr, m_width);
+        put32(ihdr + 4, m_height);
+        ihdr[8] = 8;   // bit depth
+        ihdr[9] = 0;   // grayscale
+        ihdr[10] = 0;  // deflate
+        ihdr[11] = 0;  // no filtering beyond the per-row type
+        ihdr[12] = 0;  // not interlaced
+        ok = fwrite(signature, 1, sizeof(signature), f) == sizeof(signature) &&
+            pngChunk(f, "IHDR", ihdr, sizeof(ihdr)) &&
+            pngChunk(f, "IDAT", z, zLen) &&
+            pngChunk(f, "IEND", (const unsigned char*)"", 0);
+    }
+    delete[] z;
+    return ok;
+}
@@ -0,0 +1,68 @@
+#ifndef MEMORY_FB_H
+#define MEMORY_FB_H
+
+#include <stdio.h>
+
+#include "ocher/output/FrameBuffer.h"
+
+
+/**
+ * A framebuffer in ordinary memory.  Pixels are coverage, as FreeType renders glyphs (0 is
+ * background, full scale is ink), so a page drawn here can be blitted to any other FrameBuffer
+ * of the same depth.  At 4 bpp, coverage is dithered to 16 levels and a page takes half the
+ * memory.
+ */
+class FbMemory : public FrameBuffer
+{
+public:
+    FbMemory(unsigned int width, unsigned int height, unsigned int dpi, unsigned int bpp = 8);
+    virtual ~FbMemory();
+
+    unsigned int height() { return m_height; }
+    unsigned int width() { return m_width; }
+    unsigned int dpi() { return m_dpi; }
+    unsigned int bpp() { return m_bpp; }
+
+    /**
+     * Reallocates (and clears) the pixels for a new size.
+     */
+    void resize(unsigned int width, unsigned int height, unsigned int dpi);
+
+    void clear();
+    void blit(const unsigned char *p, int x, int y, int w, int h, Blend blend = BlendDarken);
+    void blitPacked(const unsigned char *p, int x, int y, int w, int h);
+    int update(int, int, int, int, bool, Content = ContentPage) { return 0; }
+
+    /**
+     * @return The pixels, pitch() bytes per row.
+     */
+    unsigned char *pixels() { return m_pixels; }
+    unsigned int pitch() const { return m_pitch; }
+
+    /**
+     * Writes the pixels as an 8-bit grayscale image of the page as seen (dark ink on white):
+     * PNG if the path ends in ".png", otherwise PGM.
+     */
+    bool save(const char *path);
+
+protected:
+    /**
+     * Expands a row to 8-bit brightness.
+     */
+    void grayRow(unsigned int y, unsigned char *out) const;
+    bool savePgm(FILE *f);
+    bool savePng(FILE *f);
+
+    unsigned int m_width;
+    unsigned int m_height;
+    unsigned int m_dpi;
+    unsigned int m_bpp;
+    unsigned int m_pitch;
+    unsigned char *m_pixels;
+
+private:
+    FbMemory(const FbMemory&);
+    FbMemory& operator=(const FbMemory&);
+};
+
+#endif
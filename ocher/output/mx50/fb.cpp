@@ -1,6 +1,7 @@
 #include <sys/ioctl.h>
 #include <sys/mman.h>
 #include <errno.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <stdint.h>
@@ -12,21 +13,83 @@
 
 #define uint unsigned int
 #include <linux/mxcfb.h>
+#ifndef GRAYSCALE_4BIT
+#define GRAYSCALE_4BIT 0x3  // older headers predate 4 bpp grayscale
+#endif
 
+#include "clc/data/Buffer.h"
+#include "clc/os/Thread.h"
 #include "clc/support/Logger.h"
 
+#include "ocher/output/Blit.h"
 #include "ocher/output/mx50/fb.h"
+#include "ocher/settings/Settings.h"
 
 
 // Kobo Touch: MX508
 // http://mediaz.googlecode.com/svn-history/r19/trunk/ReaderZ/native/einkfb/einkfb.c
 
+/**
+ * Waits in the driver for each update in flight, in order, so that the renderer need not.
+ */
+class Mx50UpdateWaiter : public clc::Thread
+{
+public:
+    Mx50UpdateWaiter(Mx50Fb *fb) : clc::Thread("mx50 updates"), m_fb(fb), m_stop(false) {}
+
+    void stop()
+    {
+        m_fb->m_monitor.lock();
+        m_stop = true;
+        m_fb->m_monitor.notifyAll();
+        m_fb->m_monitor.unlock();
+        join();
+    }
+
+protected:
+    void run();
+
+    Mx50Fb *m_fb;
+    bool m_stop;
+};
+
+void Mx50UpdateWaiter::run()
+{
+    clc::Monitor &monitor = m_fb->m_monitor;
+    monitor.lock();
+    for (;;) {
+        while (! m_stop && m_fb->m_nInFlight == 0)
+            monitor.wait();
+        if (m_stop)
+            break;
+        int marker = m_fb->m_inFlight[0].marker;
+        monitor.unlock();
+
+        m_fb->waitComplete(marker);
+
+        monitor.lock();
+        --m_fb->m_nInFlight;
+        for (unsigned int i = 0; i < m_fb->m_nInFlight; ++i)
+            m_fb->m_inFlight[i] = m_fb->m_inFlight[i+1];
+        monitor.notifyAll();
+    }
+    monitor.unlock();
+}
+
+
 Mx50Fb::Mx50Fb() :
     m_fd(-1),
     m_fb(0),
     m_fbSize(0),
-    m_marker(-1),
-    m_clears(999)
+    m_shadow(0),
+    m_panel(0),
+    m_bpp(8),
+    m_pitch(0),
+    m_marker(0),
+    m_pages(unknownPanel),
+    m_queued(0),
+    m_nInFlight(0),
+    m_waiter(0)
 {
 }
 
@@ -51,19 +114,34 @@ bool Mx50Fb::init()
         goto fail1;
     }
 
-    // Configure for what we actually want
-    vinfo.bits_per_pixel = 8;
-    vinfo.grayscale = 1;
-    // 0 is landscape right handed, 3 is portrait
-    vinfo.rotate = 3;
-    if (ioctl(m_fd, FBIOPUT_VSCREENINFO, &vinfo) == -1) {
-        clc::Log::error("ocher.mx50", "Failed to set variable screen info: %s", strerror(errno));
+    // Configure for what we actually want.  The panel has only 16 levels of gray, so prefer 4
+    // bpp (half the memory traffic) if the driver will do it.
+    m_bpp = settings.bitsPerPixel == 4 ? 4 : 8;
+    for (;;) {
+        vinfo.bits_per_pixel = m_bpp;
+        vinfo.grayscale = m_bpp == 4 ? GRAYSCALE_4BIT : GRAYSCALE_8BIT;
+        // 0 is landscape right handed, 3 is portrait
+        vinfo.rotate = 3;
+        if (ioctl(m_fd, FBIOPUT_VSCREENINFO, &vinfo) == 0 && vinfo.bits_per_pixel == m_bpp)
+            break;
+        if (m_bpp == 8) {
+            clc::Log::error("ocher.mx50", "Failed to set variable screen info: %s", strerror(errno));
+            goto fail1;
+        }
+        clc::Log::info("ocher.mx50", "4 bpp unsupported; using 8 bpp");
+        m_bpp = 8;
+    }
+    // The driver may pad rows differently in the mode just set.
+    if (ioctl(m_fd, FBIOGET_FSCREENINFO, &finfo) == -1) {
+        clc::Log::error("ocher.mx50", "Failed to get fixed screen info: %s", strerror(errno));
         goto fail1;
     }
+    m_pitch = width() * m_bpp / 8;
 
-    clc::Log::info("ocher.mx50", "virtual %dx%d", vinfo.xres_virtual, vinfo.yres_virtual);
+    clc::Log::info("ocher.mx50", "virtual %dx%d, %d bpp, %d byte rows", vinfo.xres_virtual,
+            vinfo.yres_virtual, m_bpp, finfo.line_length);
     // Figure out the size of the screen in bytes
-    m_fbSize = vinfo.xres_virtual * vinfo.yres_virtual * vinfo.bits_per_pixel / 8;
+    m_fbSize = finfo.line_length * vinfo.yres_virtual;
 
     // Map the device to memory
     m_fb = (char*)mmap(0, m_fbSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
@@ -72,7 +150,21 @@ bool Mx50Fb::init()
         goto fail1;
     }
 
+    m_shadow = new unsigned char[m_pitch * height()];
+    m_panel = new unsigned char[m_pitch * height()];
+    memset(m_panel, 0xff, m_pitch * height());
     clear();
+
+#ifndef SINGLE_THREADED
+    m_waiter = new Mx50UpdateWaiter(this);
+    try {
+        m_waiter->start();
+    } catch (...) {
+        clc::Log::warn("ocher.mx50", "no update waiter; updates complete synchronously");
+        delete m_waiter;
+        m_waiter = 0;
+    }
+#endif
     return true;
 
 fail1:
@@ -94,6 +186,12 @@ unsigned int Mx50Fb::width()
 
 Mx50Fb::~Mx50Fb()
 {
+    if (m_waiter) {
+        m_waiter->stop();
+        delete m_waiter;
+    }
+    delete[] m_shadow;
+    delete[] m_panel;
     if (m_fd != -1) {
         close(m_fd);
         m_fd = -1;
@@ -102,35 +200,24 @@ Mx50Fb::~Mx50Fb()
 
 void Mx50Fb::clear()
 {
-    ++m_clears;
-    memset(m_fb, 0xff, m_fbSize);
+    memset(m_shadow, 0xff, m_pitch * height());
+    m_dirty.add(Rect(0, 0, width(), height()));
 }
 
-static void invcpy(unsigned char *dst, unsigned char *src, size_t n)
+void Mx50Fb::blit(const unsigned char *p, int x, int y, int w, int h, Blend blend)
 {
-#if 0
-    // Assuming src is word aligned.
-    // dst may not be aligned.
-
-#else
-    // TODO  invert then memcpy is total hack.  do it right:
-    // respect alignment, invert while copying.  (Or is it possible
-    // to have FreeType output inverted?)
-    for (size_t i = 0; i < n; ++i) {
-        src[i] = ~src[i];
-    }
-    memcpy(dst, src, n);
-#endif
+    // The device has white at full scale.
+    if (m_bpp == 4)
+        m_dirty.add(blendRect4(m_shadow, width(), height(), m_pitch, p, x, y, w, h, blend, true));
+    else
+        m_dirty.add(blendRect(m_shadow, width(), height(), m_pitch, p, x, y, w, h, blend, true));
 }
 
-void Mx50Fb::blit(unsigned char *p, int x, int y, int w, int h)
+void Mx50Fb::blitPacked(const unsigned char *p, int x, int y, int w, int h)
 {
-    for (int i = 0; i < h; ++i) {
-        invcpy(((unsigned char*)m_fb) + y*vinfo.xres_virtual + x, p, w);
-        y++;
-        p = p + w;
-    }
+    m_dirty.add(copyRect(m_shadow, width(), height(), m_pitch, m_bpp, p, x, y, w, h, true));
 }
+
 #if 0
 #if 0
     char buf[16] = {0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff, 0x00};
@@ -174,42 +261,224 @@ void Mx50Fb::blit(unsigned char *p, int x, int y, int w, int h)
         perror("ioctl MXCFB_SEND_UPDATE");
 #endif
 
-int Mx50Fb::update(int x, int y, int w, int h, bool full)
+void Mx50Fb::push(const Rect &r, bool full, Content content)
 {
-    // TODO
-    if (m_clears > 5) {
-        m_clears = 0;
-        full = true;
+    // Work in bytes, which at 4 bpp hold two pixels.
+    const int shift = m_bpp == 4 ? 1 : 0;
+    const int first = r.x >> shift;
+    const int last = (r.right() + shift) >> shift;
+    Rect changed;
+    if (full) {
+        changed = Rect(first << shift, r.y, (last - first) << shift, r.h);
     } else {
-        full = false;
+        // Narrow to the bounding box of the bytes that differ from the panel.
+        for (int j = r.y; j < r.bottom(); ++j) {
+            const unsigned char *s = m_shadow + j * m_pitch;
+            const unsigned char *d = m_panel + j * m_pitch;
+            if (memcmp(s + first, d + first, last - first) == 0)
+                continue;
+            int left = first;
+            while (s[left] == d[left])
+                ++left;
+            int right = last;
+            while (s[right-1] == d[right-1])
+                --right;
+            changed.unite(Rect(left << shift, j, (right - left) << shift, 1));
+        }
+        if (changed.empty())
+            return;
+    }
+
+    int wf = full ? WAVEFORM_MODE_GC16 : waveform(changed, content);
+    waitFor(changed);
+    const unsigned int devPitch = finfo.line_length;
+    const unsigned int offset = changed.x >> shift;
+    const unsigned int len = changed.w >> shift;
+    for (int j = changed.y; j < changed.bottom(); ++j) {
+        const unsigned char *s = m_shadow + j * m_pitch + offset;
+        memcpy(m_panel + j * m_pitch + offset, s, len);
+        memcpy(m_fb + j * devPitch + offset, s, len);
+    }
+    queue(changed, wf, full);
+}
+
+static inline bool mono(unsigned char b, bool packed)
+{
+    if (packed)
+        return ((b & 0xf) == 0 || (b & 0xf) == 0xf) && ((b >> 4) == 0 || (b >> 4) == 0xf);
+    return b == 0x00 || b == 0xff;
+}
+
+int Mx50Fb::waveform(const Rect &r, Content content)
+{
+    if (content == ContentPage)
+        return WAVEFORM_MODE_GC16;
+
+    // UI feedback in pure black and white can take the fast waveforms:  DU to get there from
+    // anything, and A2 (fastest, but only from black and white) if that is all the panel shows.
+    const bool packed = m_bpp == 4;
+    const int shift = packed ? 1 : 0;
+    bool isMono = true;
+    bool wasMono = true;
+    for (int j = r.y; j < r.bottom() && isMono; ++j) {
+        const unsigned char *s = m_shadow + j * m_pitch;
+        const unsigned char *d = m_panel + j * m_pitch;
+        for (int i = r.x >> shift; i < (r.right() + shift) >> shift; ++i) {
+            if (! mono(s[i], packed)) {
+                isMono = false;
+                break;
+            }
+            if (! mono(d[i], packed))
+                wasMono = false;
+        }
+    }
+    if (! isMono)
+        return WAVEFORM_MODE_GC16;
+    return wasMono ? WAVEFORM_MODE_A2 : WAVEFORM_MODE_DU;
+}
+
+void Mx50Fb::queue(const Rect &r, int waveform, bool full)
+{
+    for (unsigned int i = 0; i < m_queued; ++i) {
+        Update &u = m_queue[i];
+        if (u.waveform == waveform && u.full == full &&
+                r.x <= u.r.right() && u.r.x <= r.right() && r.y <= u.r.bottom() && u.r.y <= r.bottom()) {
+            u.r.unite(r);
+            return;
+        }
+    }
+    if (m_queued == maxUpdates)
+        flush();
+    Update &u = m_queue[m_queued++];
+    u.r = r;
+    u.waveform = waveform;
+    u.full = full;
+    u.marker = -1;
+}
+
+void Mx50Fb::flush()
+{
+    for (unsigned int i = 0; i < m_queued; ++i) {
+        Update &u = m_queue[i];
+        struct mxcfb_update_data region;
+
+        region.update_region.left = u.r.x;
+        region.update_region.top = u.r.y;
+        region.update_region.width = u.r.w;
+        region.update_region.height = u.r.h;
+        region.waveform_mode = u.waveform;
+        region.update_mode = u.full ? UPDATE_MODE_FULL : UPDATE_MODE_PARTIAL;
+        // The driver takes marker 0 to mean "no marker", so number from 1 and skip 0 on wrapping.
+        m_marker = m_marker == INT_MAX ? 1 : m_marker + 1;
+        region.update_marker = u.marker = m_marker;
+        region.temp = TEMP_USE_AMBIENT;
+        region.flags = 0;
+
+        if (ioctl(m_fd, MXCFB_SEND_UPDATE, &region) == -1) {
+            clc::Log::error("ocher.mx50", "MXCFB_SEND_UPDATE(%d, %d, %d, %d, %d): %s",
+                    u.r.x, u.r.y, u.r.w, u.r.h, m_marker, strerror(errno));
+            continue;
+        }
+
+        if (m_waiter) {
+            m_monitor.lock();
+            while (m_nInFlight == maxUpdates)
+                m_monitor.wait();
+            m_inFlight[m_nInFlight++] = u;
+            m_monitor.notifyAll();
+            m_monitor.unlock();
+        }
+    }
+    m_queued = 0;
+}
+
+void Mx50Fb::waitFor(const Rect &r)
+{
+    if (! m_waiter)
+        return;
+    m_monitor.lock();
+    for (;;) {
+        bool overlaps = false;
+        for (unsigned int i = 0; i < m_nInFlight && ! overlaps; ++i) {
+            Rect o = m_inFlight[i].r;
+            o.intersect(r);
+            overlaps = ! o.empty();
+        }
+        if (! overlaps)
+            break;
+        m_monitor.wait();
     }
+    m_monitor.unlock();
+}
 
-    struct mxcfb_update_data region;
+int Mx50Fb::update(int x, int y, int w, int h, bool full, Content content)
+{
+    Rect area(x, y, w, h);
+    area.intersect(Rect(0, 0, width(), height()));
 
-    region.update_region.left = x;
-    region.update_region.top = y;
-    region.update_region.width = w;
-    region.update_region.height = h;
-    region.waveform_mode = WAVEFORM_MODE_AUTO;
-    region.update_mode = full ? UPDATE_MODE_FULL : UPDATE_MODE_PARTIAL;
-    region.update_marker = ++m_marker;
-    region.temp = TEMP_USE_AMBIENT;
-    region.flags = 0;
+    if (content == ContentPage && area.w == (int)width() && area.h == (int)height()) {
+        // A page turn; every so many, flash to clear the ghosting.
+        if (m_pages == unknownPanel)
+            full = true;
+        else if (settings.fullRefreshPages && ++m_pages >= settings.fullRefreshPages)
+            full = true;
+    }
+    if (full) {
+        m_pages = 0;
+        push(area, true, content);
+    }
 
-    if (ioctl(m_fd, MXCFB_SEND_UPDATE, &region) == -1) {
-        clc::Log::error("ocher.mx50", "MXCFB_SEND_UPDATE(%d, %d, %d, %d, %d): %s",
-                x, y, w, h, m_marker, strerror(errno));
+    // Send the damage within the area; damage reaching outside of it stays pending.
+    DirtyRects pending;
+    for (unsigned int i = 0; i < m_dirty.size(); ++i) {
+        Rect r = m_dirty[i];
+        r.intersect(area);
+        if (! full)
+            push(r, false, content);
+        if (r.x != m_dirty[i].x || r.y != m_dirty[i].y || r.w != m_dirty[i].w || r.h != m_dirty[i].h)
+            pending.add(m_dirty[i]);
     }
+    m_dirty = pending;
+    flush();
     return m_marker;
 }
 
-void Mx50Fb::waitUpdate(int marker)
+void Mx50Fb::waitComplete(int marker)
 {
     if (ioctl(m_fd, MXCFB_WAIT_FOR_UPDATE_COMPLETE, &marker) == -1) {
         clc::Log::error("ocher.mx50", "MXCFB_WAIT_FOR_UPDATE_COMPLETE(%d): %s", marker, strerror(errno));
     }
 }
 
+void Mx50Fb::waitUpdate(int marker)
+{
+    if (! m_waiter) {
+        waitComplete(marker < 0 ? m_marker : marker);
+        return;
+    }
+    m_monitor.lock();
+    while (inFlight(marker))
+        m_monitor.wait();
+    m_monitor.unlock();
+}
+
+bool Mx50Fb::updateDone(int marker)
+{
+    m_monitor.lock();
+    bool done = ! inFlight(marker);
+    m_monitor.unlock();
+    return done;
+}
+
+bool Mx50Fb::inFlight(int marker) const
+{
+    for (unsigned int i = 0; i < m_nInFlight; ++i) {
+        if (marker < 0 || m_inFlight[i].marker == marker)
+            return true;
+    }
+    return false;
+}
+
 void Mx50Fb::setPixelFormat()
 {
     fb_var_screeninfo screen_info;
@@ -3,8 +3,23 @@
 
 #include <linux/mxcfb.h>
 
+#include "clc/os/Monitor.h"
+
+#include "ocher/output/DirtyRects.h"
 #include "ocher/output/FrameBuffer.h"
 
+class Mx50UpdateWaiter;
+
+/**
+ * Drawing goes to a shadow buffer in ordinary memory, and damage is recorded.  update sends the
+ * panel only the parts of the damage that differ from what the panel already shows.
+ *
+ * Updates are scheduled:  changed regions are queued and merged, each is given a waveform to
+ * suit its content (GC16 for pages; DU or A2 for black and white UI feedback), and every
+ * settings.fullRefreshPages pages a full refresh clears the ghosting.  Updates complete
+ * asynchronously; a region is only redrawn on the device once the panel is done with it, so
+ * the next page can be rendered while the panel refreshes.
+ */
 class Mx50Fb : public FrameBuffer
 {
 public:
@@ -16,28 +31,83 @@ public:
     unsigned int height();
     unsigned int width();
     unsigned int dpi() { return 170; }  // Kobo Touch -- measure it yourself!
+    unsigned int bpp() { return m_bpp; }
 
     void clear();
-    void blit(unsigned char *p, int x, int y, int w, int h);
-    int update(int x, int y, int w, int h, bool full);
+    void blit(const unsigned char *p, int x, int y, int w, int h, Blend blend = BlendDarken);
+    void blitPacked(const unsigned char *p, int x, int y, int w, int h);
+    int update(int x, int y, int w, int h, bool full, Content content = ContentPage);
 
     /**
      * @param marker  Waits on the specified update, or -1 for all
      */
     void waitUpdate(int marker = -1);
 
+    /**
+     * @return True iff the update has completed.  Does not block.
+     */
+    bool updateDone(int marker);
+
     void setPixelFormat();
     void setUpdateScheme();
     void setAutoUpdateMode(bool autoUpdate);
 
 protected:
+    friend class Mx50UpdateWaiter;
+
+    struct Update {
+        Rect r;
+        int waveform;
+        bool full;
+        int marker;
+    };
+
+    /**
+     * Copies the changed part of r (if any) to the device, and queues it for the panel.
+     * @param full  Send all of r with a flashing update, changed or not.
+     */
+    void push(const Rect &r, bool full, Content content);
+    int waveform(const Rect &r, Content content);
+    void queue(const Rect &r, int waveform, bool full);
+    /**
+     * Sends the queued updates.
+     */
+    void flush();
+    /**
+     * Waits until no update in flight overlaps r.
+     */
+    void waitFor(const Rect &r);
+    /**
+     * Blocks in the driver until the update completes.
+     */
+    void waitComplete(int marker);
+    /**
+     * @return True if the update (or with -1, any update) is in flight.  The monitor must be held.
+     */
+    bool inFlight(int marker) const;
+
     int m_fd;
     char *m_fb;
     size_t m_fbSize;
+    unsigned char *m_shadow;  ///< m_pitch x height(), in the device's pixel format
+    unsigned char *m_panel;   ///< what has been sent to the panel
+    unsigned int m_bpp;
+    unsigned int m_pitch;     ///< bytes per row of m_shadow and m_panel
+    DirtyRects m_dirty;
     int m_marker;
     struct fb_var_screeninfo vinfo;
     struct fb_fix_screeninfo finfo;
-    unsigned int m_clears;
+    static const unsigned int unknownPanel = (unsigned int)-1;
+    unsigned int m_pages;  ///< page updates since the last full refresh, or unknownPanel
+
+    static const unsigned int maxUpdates = 8;
+    Update m_queue[maxUpdates];
+    unsigned int m_queued;
+
+    clc::Monitor m_monitor;  ///< guards the in-flight updates
+    Update m_inFlight[maxUpdates];  ///< oldest first
+    unsigned int m_nInFlight;
+    Mx50UpdateWaiter *m_waiter;  ///< 0 if updates are waited for synchronously
 };
 
 #endif
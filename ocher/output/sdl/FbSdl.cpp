@@ -3,6 +3,7 @@
 
 #include "clc/support/Logger.h"
 
+#include "ocher/output/Blit.h"
 #include "ocher/output/sdl/FbSdl.h"
 
 
@@ -57,7 +58,7 @@ void FbSdl::clear()
     SDL_UpdateRect(m_screen, 0, 0, 0, 0);
 }
 
-void FbSdl::blit(unsigned char *p, int x, int y, int w, int h)
+void FbSdl::blit(const unsigned char *p, int x, int y, int w, int h, Blend blend)
 {
     clc::Log::debug("ocher.sdl", "blit");
     if ( SDL_MUSTLOCK(m_screen) ) {
@@ -66,18 +67,14 @@ void FbSdl::blit(unsigned char *p, int x, int y, int w, int h)
         }
     }
 
-    //SDL_BlitSurface(m_screen, NULL, 
-    for (int i = 0; i < h; ++i) {
-        memcpy(((unsigned char*)m_screen->pixels) + y*m_screen->pitch + x, p, w);
-        y++;
-        p = p + w;
-    }
+    blendRect((unsigned char*)m_screen->pixels, m_screen->w, m_screen->h, m_screen->pitch,
+            p, x, y, w, h, blend, false);
     if ( SDL_MUSTLOCK(m_screen) ) {
         SDL_UnlockSurface(m_screen);
     }
 }
 
-int FbSdl::update(int x, int y, int w, int h, bool /*full*/)
+int FbSdl::update(int x, int y, int w, int h, bool /*full*/, Content /*content*/)
 {
     clc::Log::debug("ocher.sdl", "update");
     SDL_Rect dest;
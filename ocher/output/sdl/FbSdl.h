@@ -19,8 +19,8 @@ public:
     unsigned int dpi();
 
     void clear();
-    void blit(unsigned char *p, int x, int y, int w, int h);
-    int update(int x, int y, int w, int h, bool full=true);
+    void blit(const unsigned char *p, int x, int y, int w, int h, Blend blend = BlendDarken);
+    int update(int x, int y, int w, int h, bool full=true, Content content = ContentPage);
 
 protected:
     SDL_Surface *m_screen;
@@ -2,7 +2,8 @@
 #define OCHER_OPTIONS_H
 
 struct Options {
-    Options() : verbose(0), dir(0), inFd(0), outFd(1) {}
+    Options() : verbose(0), dir(0), inFd(0), outFd(1), width(600), height(800), dpi(167),
+        dumpDir(0), dumpFormat("png"), exportFormat(0), exportDir(0) {}
 
     int verbose;
 
@@ -13,6 +14,16 @@ struct Options {
 
     int inFd;
     int outFd;
+
+    // For drivers without a display of their own:
+    unsigned int width;
+    unsigned int height;
+    unsigned int dpi;
+    const char *dumpDir;  ///< write each page here as an image, or 0
+    const char *dumpFormat;  ///< "png" or "pgm"
+
+    const char *exportFormat;  ///< "text" or "ansi" to export the books rather than read, or 0
+    const char *exportDir;  ///< write each exported book here, rather than to stdout
 };
 
 extern struct Options opt;
@@ -14,6 +14,7 @@ Settings::Settings() :
     minutesUntilPowerOff(60),
     wirelessAirplaneMode(0),
     fullRefreshPages(6),
+    bitsPerPixel(4),
     showPageNumbers(1),
     fontPoints(10),
     marginTop(10),
@@ -21,6 +22,25 @@ Settings::Settings() :
     marginLeft(10),
     marginRight(10)
 {
+    for (unsigned int i = 0; i < maxRecentFontPoints; ++i)
+        recentFontPoints[i] = 0;
+}
+
+void Settings::setFontPoints(int points)
+{
+    if (points == fontPoints)
+        return;
+    int recent[maxRecentFontPoints];
+    unsigned int n = 0;
+    recent[n++] = fontPoints;
+    for (unsigned int i = 0; i < maxRecentFontPoints && n < maxRecentFontPoints; ++i) {
+        const int p = recentFontPoints[i];
+        if (p && p != points && p != fontPoints)
+            recent[n++] = p;
+    }
+    for (unsigned int i = 0; i < maxRecentFontPoints; ++i)
+        recentFontPoints[i] = i < n ? recent[i] : 0;
+    fontPoints = points;
 }
 
 void Settings::load()
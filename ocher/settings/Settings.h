@@ -30,10 +30,17 @@ struct Settings {
     int wirelessAirplaneMode;  ///< Only turn on wireless on-demand?
     
     unsigned int fullRefreshPages;
+    unsigned int bitsPerPixel;  ///< 4 or 8, where the display can do either
 
     int showPageNumbers;
 
     int fontPoints;
+    /**
+     * Changes fontPoints, remembering the size left in recentFontPoints.
+     */
+    void setFontPoints(int points);
+    static const unsigned int maxRecentFontPoints = 2;
+    int recentFontPoints[maxRecentFontPoints];  ///< other sizes used lately, latest first; 0 if none
     // force font
     // force font size
     // line spacing
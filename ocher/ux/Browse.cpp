@@ -0,0 +1,113 @@
+#include "clc/data/Buffer.h"
+
+#include "ocher/settings/Settings.h"
+#include "ocher/ux/Browse.h"
+#include "ocher/ux/Paginator.h"
+#include "ocher/ux/Renderer.h"
+
+
+int Browse::show(Place &place, Renderer& renderer, Paginator& paginator)
+{
+    if (place.pageNum >= 0) {
+        place.shown = paginator.waitFor(place.pageNum) ? renderer.render(place.pageNum, true) : -1;
+    } else {
+        place.next = place.at;
+        place.shown = renderer.renderAt(&place.next);
+    }
+    return place.shown;
+}
+
+bool Browse::forward(Place &place, Renderer& renderer)
+{
+    if (place.pageNum >= 0) {
+        ++place.pageNum;
+        return true;
+    }
+    if (place.shown != 0)
+        return false;
+    place.at = place.next;
+    rejoin(place, renderer);
+    return true;
+}
+
+void Browse::back(Place &place, Renderer& renderer)
+{
+    if (place.pageNum >= 0) {
+        if (place.pageNum > 0)
+            --place.pageNum;
+    } else if (renderer.pageBefore(&place.at) == 0) {
+        rejoin(place, renderer);
+    }
+}
+
+void Browse::rejoin(Place &place, Renderer& renderer)
+{
+    if (place.pageNum >= 0)
+        return;
+    const unsigned int page = renderer.pageOf(place.at.layoutOffset, place.at.strOffset);
+    unsigned int layoutOffset = 0;
+    unsigned int strOffset = 0;
+    if (page && ! renderer.pageBreak(page-1, &layoutOffset, &strOffset))
+        return;
+    if (layoutOffset == place.at.layoutOffset && strOffset == place.at.strOffset)
+        place.pageNum = page;
+}
+
+clc::Buffer Browse::pageStatus(const Place &place, Renderer& renderer, Paginator& paginator)
+{
+    // By position, the page holding it so far as paginated.
+    const unsigned int pageNum = place.pageNum >= 0 ? place.pageNum :
+        renderer.pageOf(place.at.layoutOffset, place.at.strOffset);
+    bool done;
+    unsigned int pages = paginator.pages(&done);
+    unsigned int estimate = paginator.estimate();
+    clc::Buffer status;
+    if (done || ! estimate)
+        status.format("page %u of %s%u", pageNum + 1, done ? "" : "\xe2\x89\xa5", pages);
+    else
+        status.format("page %u of ~%u", pageNum + 1, estimate);
+
+    // A lower bound is no basis for a position.
+    const unsigned int total = done ? pages : estimate;
+    if (total) {
+        static const unsigned int barWidth = 20;
+        unsigned int filled = (pageNum + 1) * barWidth / total;
+        if (filled > barWidth)
+            filled = barWidth;
+        status += "  [";
+        status.append('#', filled);
+        status.append('-', barWidth - filled);
+        status += "]";
+    }
+    return status;
+}
+
+void Browse::setFontPoints(int points, Place &place, Renderer& renderer, Paginator& paginator)
+{
+    Pagination::Break at;
+    at.layoutOffset = 0;
+    at.strOffset = 0;
+    if (place.pageNum < 0)
+        at = place.at;
+    else if (place.pageNum &&
+            ! renderer.pageBreak(place.pageNum-1, &at.layoutOffset, &at.strOffset, &at.attrs))
+        return;
+
+    paginator.stop();
+    if (renderer.setFontPoints(points))
+        settings.setFontPoints(points);
+    paginator.repaginate();
+
+    // Restored (or already past the place), the page holding it.  Otherwise, rather than wait
+    // for pagination to get there, read on from the same text.
+    bool done;
+    const unsigned int known = paginator.pages(&done);
+    const unsigned int page = renderer.pageOf(at.layoutOffset, at.strOffset);
+    if (done || page + 1 < known) {
+        place.pageNum = page;
+    } else {
+        place.pageNum = -1;
+        place.at = at;
+        rejoin(place, renderer);
+    }
+}
@@ -1,6 +1,11 @@
 #ifndef OCHER_UX_BROWSE_H
 #define OCHER_UX_BROWSE_H
 
+#include "clc/data/Buffer.h"
+
+#include "ocher/ux/Pagination.h"
+
+class Paginator;
 class Renderer;
 
 class Browse
@@ -12,9 +17,64 @@ public:
     virtual bool init() { return true; }
     // TODO:  instead return some epub meta record and/or requested action
     virtual void browse() = 0;
-    virtual void read(Renderer& renderer) = 0;
+    /**
+     * @param paginator  Still paginating, perhaps; see Paginator::waitFor before turning to a
+     *      page.
+     */
+    virtual void read(Renderer& renderer, Paginator& paginator) = 0;
+
+protected:
+    /**
+     * Where the reader is:  a page, or where pagination has not reached yet, the position a
+     * page starts at.  Pages by position are turned with Renderer::renderAt and
+     * Renderer::pageBefore, until one starts at a page break.
+     */
+    struct Place {
+        Place() : pageNum(0), shown(-1) {}
+
+        int pageNum;  ///< or -1 if by position
+        Pagination::Break at;  ///< by position, where the page starts
+        Pagination::Break next;  ///< by position, where the next page starts once shown
+        int shown;  ///< what showing the page returned (see Renderer::render)
+    };
+
+    /**
+     * Shows the page, waiting until it is paginated if by number.
+     * @return As Renderer::render
+     */
+    static int show(Place &place, Renderer& renderer, Paginator& paginator);
+
+    /**
+     * Turns to the next page, once the page is shown.
+     * @return false if the page shown ends the book (for pages by number, show says so)
+     */
+    static bool forward(Place &place, Renderer& renderer);
+
+    /**
+     * Turns to the previous page, if any.
+     */
+    static void back(Place &place, Renderer& renderer);
+
+    /**
+     * @return "page N of M" and a bar of the position in the book.  While paginating the count
+     *      is estimated ("~M"), or failing that is a lower bound ("\u2265M").
+     */
+    static clc::Buffer pageStatus(const Place &place, Renderer& renderer, Paginator& paginator);
+
+    /**
+     * Changes the font size, keeping the reader's place:  the book is repaginated (at once, if
+     * it was paginated at that size lately) and the place is mapped through the text its page
+     * starts with.  Never waits for pagination:  short of the place, the place is by position,
+     * starting with that text.
+     */
+    static void setFontPoints(int points, Place &place, Renderer& renderer,
+            Paginator& paginator);
+
+    /**
+     * Turns a place by position into a page number, if it starts a paginated page.
+     */
+    static void rejoin(Place &place, Renderer& renderer);
 };
 
 
 #endif
-
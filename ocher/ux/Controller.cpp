@@ -1,10 +1,17 @@
+#include <limits.h>
+#include <stdlib.h>
+
 #include "mxml.h"
 
+#include "clc/crypto/MurmurHash2.h"
 #include "clc/storage/File.h"
+#include "clc/storage/Path.h"
 #include "clc/support/Logger.h"
 
+#include "ocher/device/Filesystem.h"
 #include "ocher/ux/Factory.h"
 #include "ocher/ux/Controller.h"
+#include "ocher/ux/Paginator.h"
 #include "ocher/settings/Options.h"
 
 // TODO:  replace all this hardcoded stuff with factory:
@@ -14,67 +21,87 @@
 #include "ocher/fmt/text/LayoutText.h"
 
 
+/**
+ * Where the book's paginations are persisted, and what they must have been saved with to be
+ * reused:  the layout version and the book (by path, size, and modification time).  See
+ * Paginator::paginate.
+ */
+static void paginationKey(clc::File &book, clc::Buffer &stem, clc::Buffer &key)
+{
+    char real[PATH_MAX];
+    const char *name = realpath(book.getName().c_str(), real) ? real : book.getName().c_str();
+    time_t atime, mtime, ctime;
+    book.getTimes(atime, mtime, ctime);
+
+    key.format("ocher layout %u\n", Layout::version);
+    key.appendFormat("book %s %llu %lld\n", name, (unsigned long long)book.size(),
+            (long long)mtime);
+
+    char file[16];
+    sprintf(file, "%08x", clc::hash(name, strlen(name)));
+    stem = fs.getCache();
+    clc::Path::join(stem, file);
+}
+
 Controller::Controller(UiFactory *factory) :
     m_factory(factory)
 {
 }
 
-void Controller::run()
+Layout *Controller::loadBook(const char *file, clc::Buffer &memLayout,
+        std::list<EmbeddedFont> &fonts)
 {
-    Browse& browser = m_factory->getBrowser();
-
-    // TODO:  workflow
-
-    browser.browse();
-
-    clc::Buffer memLayout;
-
     // TODO:  complete hardcoded hack to test with here...
     // TODO:  probe file type
     // TODO:  rework Layout constructors to have separate init due to scoping
 
     Layout *layout;
-    clc::File f(opt.file);
+    clc::File f(file);
     char buf[2];
     if (f.read(buf, 2) != 2 || buf[0] != 'P' || buf[1] != 'K') {
-        Text text(opt.file);
+        Text text(file);
         layout = new LayoutText(&text);
-        clc::Log::info("ocher", "Loading %s: %s", text.getFormatName().c_str(), opt.file);
+        clc::Log::info("ocher", "Loading %s: %s", text.getFormatName().c_str(), file);
         memLayout = layout->unlock();
     } else {
-        Epub epub(opt.file);
+        Epub epub(file);
         layout = new LayoutEpub(&epub);
 
-        clc::Log::info("ocher", "Loading %s: %s", epub.getFormatName().c_str(), opt.file);
-
-        clc::Buffer html;
-        for (int i = 0; ; i++) {
-            if (epub.getSpineItemByIndex(i, html) != 0)
-                break;
-            mxml_node_t *tree = epub.parseXml(html);
-            if (tree) {
-                ((LayoutEpub*)layout)->append(tree);
-                mxmlDelete(tree);
-            } else {
-                clc::Log::warn("ocher", "No tree found for spine item %d", i);
-            }
-        }
+        clc::Log::info("ocher", "Loading %s: %s", epub.getFormatName().c_str(), file);
+
+        ((LayoutEpub*)layout)->appendSpine();
         memLayout = layout->unlock();
+        epub.getFonts(fonts);
     }
+    return layout;
+}
+
+void Controller::run()
+{
+    Browse& browser = m_factory->getBrowser();
+
+    // TODO:  workflow
+
+    browser.browse();
+
+    clc::Buffer memLayout;
+    std::list<EmbeddedFont> fonts;
+    Layout *layout = loadBook(opt.file, memLayout, fonts);
+    clc::File f(opt.file);
 
     Renderer& renderer = m_factory->getRenderer();
+    renderer.setFonts(fonts);
     renderer.set(memLayout);
 
-    // Run through all pages without blitting to re-paginate
-    // TODO:  speed stats
-    // TODO:  faster? max_advance_width
-    for (int pageNum = 0; ; pageNum++) {
-        if (renderer.render(pageNum, false) != 0)
-            break;
-        clc::Log::info("ocher", "Paginated page %d", pageNum);
-    }
+    // Paginate in the background while the first pages are read.
+    clc::Buffer cacheStem;
+    clc::Buffer key;
+    paginationKey(f, cacheStem, key);
+    Paginator paginator(renderer);
+    paginator.paginate(cacheStem.c_str(), key);
 
-    browser.read(renderer);
+    browser.read(renderer, paginator);
+    paginator.stop();
 
     delete layout;
 }
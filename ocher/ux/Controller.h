@@ -1,8 +1,15 @@
 #ifndef OCHER_CONTROLLER_H
 #define OCHER_CONTROLLER_H
 
+#include <list>
+
+#include "clc/data/Buffer.h"
+
+#include "ocher/fmt/Format.h"
 #include "ocher/ux/Factory.h"
 
+class Layout;
+
 class Controller
 {
 public:
@@ -10,6 +17,15 @@ public:
 
     void run();
 
+    /**
+     * Lays out the book (epub or text, by content).
+     * @param memLayout  Set to the layout bytecode, which is valid until the Layout is deleted.
+     * @param fonts  Appended with the fonts the book embeds.
+     * @return The Layout, for the caller to delete.
+     */
+    static Layout *loadBook(const char *file, clc::Buffer &memLayout,
+            std::list<EmbeddedFont> &fonts);
+
 protected:
     void open();
 
@@ -0,0 +1,140 @@
+#include <stdint.h>
+#include <algorithm>
+
+#include "clc/support/Debug.h"
+#include "clc/support/Logger.h"
+
+#include "ocher/fmt/Layout.h"
+#include "ocher/ux/PageEstimate.h"
+#include "ocher/ux/Renderer.h"
+
+
+PageEstimate::PageEstimate() :
+    m_bytes(0),
+    m_sampleBytes(0),
+    m_samplePages(0)
+{
+}
+
+void PageEstimate::scan(const clc::Buffer &layout)
+{
+    m_strs.clear();
+    m_chapters.clear();
+    m_bytes = 0;
+    m_sampleBytes = 0;
+    m_samplePages = 0;
+
+    // Follows the bytecode as Renderer::renderPage does, but only for the strings and nesting.
+    const unsigned int N = layout.size();
+    const char *raw = layout.data();
+    int depth = 0;
+    bool blank = true;  // since the chapter started
+    Chapter c;
+    c.layoutOffset = 0;
+    c.bytes = 0;
+    m_chapters.push_back(c);
+    for (unsigned int i = 0; i < N; ) {
+        ASSERT(i+2 <= N);
+        uint16_t code = *(uint16_t*)(raw+i);
+        i += 2;
+
+        unsigned int opType = (code>>12)&0xf;
+        unsigned int op = (code>>8)&0xf;
+        unsigned int arg = code & 0xff;
+        if (opType == Layout::OpPushTextAttr || opType == Layout::OpPushLineAttr) {
+            ++depth;
+        } else if (opType == Layout::OpCmd && op == Layout::CmdPopAttr) {
+            depth -= arg ? arg : 1;
+        } else if (opType == Layout::OpCmd && op == Layout::CmdOutputStr) {
+            clc::Buffer *str = *(clc::Buffer**)(raw+i);
+            Str s;
+            s.layoutOffset = i-2;
+            s.bytes = m_bytes;
+            s.outside = depth == 0;
+            m_strs.push_back(s);
+            if (blank)
+                blank = Renderer::isBlank(str, 0);
+            m_bytes += str->size();
+            i += sizeof(clc::Buffer*) + sizeof(uint8_t*);
+        } else if (opType == Layout::OpCmd && op == Layout::CmdForcePage) {
+            // As Renderer::renderFrom, which only breaks the page after text.
+            if (! blank) {
+                c.layoutOffset = i-2;
+                c.bytes = m_bytes;
+                m_chapters.push_back(c);
+            }
+            blank = true;
+        }
+    }
+}
+
+std::vector<unsigned int> PageEstimate::chapters() const
+{
+    std::vector<unsigned int> starts;
+    for (unsigned int i = 0; i < m_chapters.size(); ++i)
+        starts.push_back(m_chapters[i].layoutOffset);
+    return starts;
+}
+
+void PageEstimate::sample(Renderer &renderer, unsigned int samples, unsigned int samplePages)
+{
+    for (unsigned int k = 1; k <= samples; ++k) {
+        // The first string outside of attributes (such as a paragraph start) past the point.
+        const unsigned int target = (uint64_t)m_bytes * k / (samples + 1);
+        std::vector<Str>::const_iterator it = m_strs.begin();
+        while (it != m_strs.end() && (it->bytes < target || ! it->outside))
+            ++it;
+        if (it == m_strs.end())
+            break;
+
+        unsigned int layoutOffset = it->layoutOffset;
+        unsigned int strOffset = 0;
+        for (unsigned int p = 0; p < samplePages; ++p) {
+            unsigned int start = bytesBefore(layoutOffset, strOffset);
+            // A page ending with the book or a chapter is not full, so says little.
+            if (renderer.measure(&layoutOffset, &strOffset) != 0 || isChapter(layoutOffset))
+                break;
+            m_sampleBytes += bytesBefore(layoutOffset, strOffset) - start;
+            m_samplePages++;
+        }
+    }
+    clc::Log::debug("ocher.pagination", "sampled %u pages of %u bytes in %u", m_samplePages,
+            m_sampleBytes, m_bytes);
+}
+
+bool PageEstimate::isChapter(unsigned int layoutOffset) const
+{
+    std::vector<Chapter>::const_iterator it = std::lower_bound(m_chapters.begin(),
+            m_chapters.end(), layoutOffset, chapterBefore);
+    return it != m_chapters.end() && it->layoutOffset == layoutOffset;
+}
+
+unsigned int PageEstimate::bytesBefore(unsigned int layoutOffset, unsigned int strOffset) const
+{
+    std::vector<Str>::const_iterator it = std::lower_bound(m_strs.begin(), m_strs.end(),
+            layoutOffset, before);
+    if (it == m_strs.end())
+        return m_bytes;
+    return it->bytes + strOffset;
+}
+
+unsigned int PageEstimate::estimate(unsigned int pages, unsigned int bytes) const
+{
+    // Pooled, so that the samples count for less as the book's own pages accumulate.
+    const uint64_t sampledBytes = (uint64_t)bytes + m_sampleBytes;
+    const unsigned int sampledPages = pages + m_samplePages;
+    if (! sampledPages || ! sampledBytes)
+        return 0;
+    // Each chapter's remainder, rounded up to whole pages.
+    uint64_t more = 0;
+    unsigned int from = bytes;
+    for (unsigned int i = 1; i <= m_chapters.size(); ++i) {
+        const unsigned int to = i < m_chapters.size() ? m_chapters[i].bytes : m_bytes;
+        if (to <= from)
+            continue;
+        more += ((uint64_t)(to - from) * sampledPages + sampledBytes - 1) / sampledBytes;
+        from = to;
+    }
+    // At least the page after those paginated.
+    return pages + (more ? more : 1);
+}
@@ -0,0 +1,74 @@
+#ifndef OCHER_UX_PAGEESTIMATE_H
+#define OCHER_UX_PAGEESTIMATE_H
+
+#include <vector>
+
+#include "clc/data/Buffer.h"
+
+class Renderer;
+
+
+/**
+ * Estimates how many pages a book has before it is paginated, from how much text fits on a
+ * page.  A few pages spread through the book are measured with the renderer's real metrics,
+ * and the text per page is extrapolated over the rest of the layout.  The estimate is refined
+ * with the text per page observed as pagination advances.
+ *
+ * Text is counted in bytes, which is proportional enough to characters for an estimate.  As
+ * chapters start new pages, each is estimated separately.
+ */
+class PageEstimate
+{
+public:
+    PageEstimate();
+
+    /**
+     * Indexes the strings and chapters of the layout.
+     */
+    void scan(const clc::Buffer &layout);
+
+    /**
+     * @return Where each chapter starts:  0, then each CmdForcePage that ends a page, ie that
+     *      follows text.  Blank chapters are thus merged with the next.
+     */
+    std::vector<unsigned int> chapters() const;
+
+    /**
+     * Measures samplePages pages at each of samples points spread through the layout.
+     */
+    void sample(Renderer &renderer, unsigned int samples=3, unsigned int samplePages=2);
+
+    /**
+     * @return Bytes of text before the offset, as passed to Pagination::set.
+     */
+    unsigned int bytesBefore(unsigned int layoutOffset, unsigned int strOffset) const;
+
+    /**
+     * @param pages  Pages paginated exactly so far.
+     * @param bytes  Bytes of text on those pages.
+     * @return Estimated total pages, or 0 if there is no basis for an estimate yet.
+     */
+    unsigned int estimate(unsigned int pages, unsigned int bytes) const;
+
+protected:
+    struct Str {
+        unsigned int layoutOffset;  ///< of its CmdOutputStr
+        unsigned int bytes;  ///< before it
+        bool outside;  ///< outside of any attributes, so a page can be measured from it
+    };
+    struct Chapter {
+        unsigned int layoutOffset;
+        unsigned int bytes;  ///< before it
+    };
+    static bool before(const Str &s, unsigned int layoutOffset) { return s.layoutOffset < layoutOffset; }
+    static bool chapterBefore(const Chapter &c, unsigned int layoutOffset) { return c.layoutOffset < layoutOffset; }
+    bool isChapter(unsigned int layoutOffset) const;
+
+    std::vector<Str> m_strs;  ///< by layoutOffset
+    std::vector<Chapter> m_chapters;  ///< by layoutOffset
+    unsigned int m_bytes;  ///< in the layout
+    unsigned int m_sampleBytes;
+    unsigned int m_samplePages;
+};
+
+#endif
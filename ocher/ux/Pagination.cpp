@@ -1,54 +1,314 @@
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "clc/storage/File.h"
 #include "clc/support/Debug.h"
 #include "clc/support/Logger.h"
 
 #include "ocher/ux/Pagination.h"
 
 
+// Followed by the key's length and the key, the number of attribute stacks and the stacks (depth,
+// clamped, then ops), the number of pages, and the pages, all in native byte order (the cache
+// does not leave the device).
+const char Pagination::magic[8] = { 'O', 'C', 'H', 'E', 'R', 'P', 'G', '3' };
+
+bool Pagination::AttrStack::operator==(const AttrStack &other) const
+{
+    return depth == other.depth && clamped == other.clamped &&
+        memcmp(ops, other.ops, depth * sizeof(ops[0])) == 0;
+}
+
 Pagination::Pagination() :
+    m_attrStacks(1),
     m_numPages(0)
 {
 }
 
 Pagination::~Pagination()
 {
-    flush();
 }
 
 void Pagination::flush()
 {
     m_numPages = 0;
-    // TODO: delete
+    m_blocks.clear();
+    m_bits.clear();
+    m_attrStacks.resize(1);
+}
+
+unsigned int Pagination::bitsFor(unsigned int v)
+{
+    unsigned int n = 0;
+    while (v) {
+        ++n;
+        v >>= 1;
+    }
+    return n;
+}
+
+uint32_t Pagination::readBits(unsigned int bit, unsigned int width) const
+{
+    // At most 32 bits from within two words; m_bits keeps a spare word for the last field.
+    const uint64_t w = m_bits[bit/32] | ((uint64_t)m_bits[bit/32 + 1] << 32);
+    return (uint32_t)((w >> (bit % 32)) & (((uint64_t)1 << width) - 1));
+}
+
+void Pagination::writeBits(unsigned int bit, unsigned int width, uint32_t v)
+{
+    if (m_bits.size() < bit/32 + 2)
+        m_bits.resize(bit/32 + 2, 0);
+    const uint64_t mask = (((uint64_t)1 << width) - 1) << (bit % 32);
+    uint64_t w = m_bits[bit/32] | ((uint64_t)m_bits[bit/32 + 1] << 32);
+    w = (w & ~mask) | (((uint64_t)v << (bit % 32)) & mask);
+    m_bits[bit/32] = (uint32_t)w;
+    m_bits[bit/32 + 1] = (uint32_t)(w >> 32);
 }
 
-void Pagination::set(unsigned int pageNum, unsigned int layoutOffset, unsigned int strOffset /* TODO attrs */)
+void Pagination::entry(unsigned int pageNum, Entry *e) const
+{
+    const Block &b = m_blocks[pageNum / pagesPerBlock];
+    const unsigned int bit = b.bit + (pageNum % pagesPerBlock) * b.entryBits();
+    e->layoutOffset = b.layoutOffset + readBits(bit, b.layoutBits);
+    e->strOffset = readBits(bit + b.layoutBits, b.strBits);
+    e->attrs = readBits(bit + b.layoutBits + b.strBits, b.attrBits);
+}
+
+void Pagination::pack(Block &b, unsigned int i, const Entry &e)
+{
+    const unsigned int bit = b.bit + i * b.entryBits();
+    writeBits(bit, b.layoutBits, e.layoutOffset - b.layoutOffset);
+    writeBits(bit + b.layoutBits, b.strBits, e.strOffset);
+    writeBits(bit + b.layoutBits + b.strBits, b.attrBits, e.attrs);
+}
+
+unsigned int Pagination::intern(const AttrStack &attrs)
+{
+    // Linear, but books open few distinct combinations of attributes.
+    for (unsigned int i = 0; i < m_attrStacks.size(); ++i) {
+        if (m_attrStacks[i] == attrs)
+            return i;
+    }
+    m_attrStacks.push_back(attrs);
+    return m_attrStacks.size() - 1;
+}
+
+void Pagination::set(unsigned int pageNum, unsigned int layoutOffset, unsigned int strOffset,
+        const AttrStack &attrs)
 {
     ASSERT(pageNum <= m_numPages);
-    unsigned int chunk = pageNum / pagesPerChunk;
-    if (pageNum == m_numPages) {
-        if (chunk == m_pages.countItems()) {
-            m_pages.add(new PageMapping[pagesPerChunk]);
+    const unsigned int i = pageNum % pagesPerBlock;
+
+    // Drop this page and those after it; the block being appended to keeps its earlier entries.
+    m_blocks.resize((pageNum + pagesPerBlock - 1) / pagesPerBlock);
+    if (i == 0) {
+        Block b;
+        b.layoutOffset = layoutOffset;
+        b.bit = 0;
+        if (! m_blocks.empty()) {
+            // Right after the previous block's entries, rather than after any dropped ones.
+            const Block &prev = m_blocks.back();
+            b.bit = (prev.bit + pagesPerBlock * prev.entryBits() + 31) / 32 * 32;
         }
+        b.layoutBits = 0;
+        b.strBits = 0;
+        b.attrBits = 0;
+        m_blocks.push_back(b);
     }
-    struct PageMapping *mapping = (struct PageMapping*)m_pages.ItemAtFast(chunk);
-    mapping += pageNum % pagesPerChunk;
-    mapping->layoutOffset = layoutOffset;
-    mapping->strOffset = strOffset;
+    m_numPages = pageNum;
+
+    Block &b = m_blocks.back();
+    ASSERT(layoutOffset >= b.layoutOffset);
+    Entry e;
+    e.layoutOffset = layoutOffset;
+    e.strOffset = strOffset;
+    e.attrs = intern(attrs);
+    const unsigned int layoutBits = bitsFor(layoutOffset - b.layoutOffset);
+    const unsigned int strBits = bitsFor(strOffset);
+    const unsigned int attrBits = bitsFor(e.attrs);
+    if (layoutBits > b.layoutBits || strBits > b.strBits || attrBits > b.attrBits) {
+        // Widen the block, repacking its entries.
+        Entry entries[pagesPerBlock];
+        for (unsigned int j = 0; j < i; ++j)
+            entry(pageNum - i + j, &entries[j]);
+        if (layoutBits > b.layoutBits)
+            b.layoutBits = layoutBits;
+        if (strBits > b.strBits)
+            b.strBits = strBits;
+        if (attrBits > b.attrBits)
+            b.attrBits = attrBits;
+        for (unsigned int j = 0; j < i; ++j)
+            pack(b, j, entries[j]);
+    }
+    pack(b, i, e);
     m_numPages = pageNum + 1;
-    clc::Log::debug("ocher.pagination", "set page %u breaks at layoutOffset %u strOffset %u", pageNum, layoutOffset, strOffset);
+    clc::Log::debug("ocher.pagination", "set page %u breaks at layoutOffset %u strOffset %u attrs %u",
+            pageNum, layoutOffset, strOffset, e.attrs);
 }
 
-bool Pagination::get(unsigned int pageNum, unsigned int *layoutOffset, unsigned int *strOffset /* TODO attrs */)
+bool Pagination::get(unsigned int pageNum, unsigned int *layoutOffset, unsigned int *strOffset,
+        AttrStack *attrs)
 {
-    unsigned int chunk = pageNum / pagesPerChunk;
-    if (chunk > m_pages.countItems()) {
+    if (pageNum >= m_numPages) {
         return false;
     }
-    struct PageMapping *mapping = (struct PageMapping*)m_pages.ItemAtFast(chunk);
-    mapping += pageNum % pagesPerChunk;
-    *layoutOffset = mapping->layoutOffset;
-    *strOffset = mapping->strOffset;
+    Entry e;
+    entry(pageNum, &e);
+    *layoutOffset = e.layoutOffset;
+    *strOffset = e.strOffset;
+    if (attrs)
+        *attrs = m_attrStacks[e.attrs];
     clc::Log::debug("ocher.pagination", "found page %u breaks at layoutOffset %u strOffset %u", pageNum, *layoutOffset, *strOffset);
     return true;
 }
 
+unsigned int Pagination::find(unsigned int layoutOffset, unsigned int strOffset) const
+{
+    // The page is the number of breaks at or before the offsets.
+    unsigned int lo = 0;
+    unsigned int hi = m_numPages;
+    while (lo < hi) {
+        const unsigned int mid = lo + (hi - lo) / 2;
+        Entry e;
+        entry(mid, &e);
+        if (e.layoutOffset < layoutOffset || (e.layoutOffset == layoutOffset && e.strOffset <= strOffset))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+void Pagination::save(const char *path, const clc::Buffer &key)
+{
+    clc::Buffer b;
+    b.append(magic, sizeof(magic));
+    uint32_t n = key.size();
+    b.append((const char*)&n, sizeof(n));
+    b.append(key);
+    n = m_attrStacks.size();
+    b.append((const char*)&n, sizeof(n));
+    for (unsigned int i = 0; i < m_attrStacks.size(); ++i) {
+        const AttrStack &attrs = m_attrStacks[i];
+        uint16_t depth = attrs.depth;
+        uint16_t clamped = attrs.clamped;
+        b.append((const char*)&depth, sizeof(depth));
+        b.append((const char*)&clamped, sizeof(clamped));
+        b.append((const char*)attrs.ops, depth * sizeof(attrs.ops[0]));
+    }
+    n = m_numPages;
+    b.append((const char*)&n, sizeof(n));
+    for (unsigned int i = 0; i < m_numPages; ++i) {
+        Entry e;
+        entry(i, &e);
+        uint32_t fields[3] = { e.layoutOffset, e.strOffset, e.attrs };
+        b.append((const char*)fields, sizeof(fields));
+    }
+
+    // Written aside and renamed into place, so that a crash cannot leave a torn table.
+    clc::Buffer tmp(path);
+    tmp += ".tmp";
+    try {
+        clc::File f(tmp, "w");
+        f.write(b);
+        f.close();
+    } catch (...) {
+        clc::Log::warn("ocher.pagination", "failed to write %s", tmp.c_str());
+        ::unlink(tmp.c_str());
+        return;
+    }
+    if (::rename(tmp.c_str(), path) != 0) {
+        clc::Log::warn("ocher.pagination", "failed to rename %s", tmp.c_str());
+        ::unlink(tmp.c_str());
+        return;
+    }
+    clc::Log::info("ocher.pagination", "saved %u page breaks to %s", m_numPages, path);
+}
+
+bool Pagination::load(const char *path, const clc::Buffer &key)
+{
+    clc::Buffer b;
+    try {
+        clc::File f(path);
+        f.readRest(b);
+    } catch (...) {
+        return false;
+    }
 
+    const char *p = b.data();
+    const char *end = p + b.size();
+    uint32_t n;
+    if (end - p < (ssize_t)(sizeof(magic) + sizeof(n)) || memcmp(p, magic, sizeof(magic)) != 0) {
+        clc::Log::warn("ocher.pagination", "%s is not a page table", path);
+        return false;
+    }
+    p += sizeof(magic);
+    memcpy(&n, p, sizeof(n));
+    p += sizeof(n);
+    if (n != key.size() || (size_t)(end - p) < n + sizeof(n) || memcmp(p, key.data(), n) != 0) {
+        clc::Log::info("ocher.pagination", "%s is stale", path);
+        return false;
+    }
+    p += n;
+    memcpy(&n, p, sizeof(n));
+    p += sizeof(n);
+    // Each stack is at least its depth and clamped.  Divide rather than multiply, which could
+    // wrap, and check before allocating.
+    bool ok = n <= (size_t)(end - p) / (2 * sizeof(uint16_t));
+    std::vector<AttrStack> stacks(ok ? n : 0);
+    for (unsigned int i = 0; ok && i < stacks.size(); ++i) {
+        uint16_t depth;
+        uint16_t clamped;
+        ok = (size_t)(end - p) >= sizeof(depth) + sizeof(clamped);
+        if (ok) {
+            memcpy(&depth, p, sizeof(depth));
+            p += sizeof(depth);
+            memcpy(&clamped, p, sizeof(clamped));
+            p += sizeof(clamped);
+            ok = depth <= AttrStack::maxDepth &&
+                (size_t)(end - p) >= depth * sizeof(stacks[i].ops[0]);
+        }
+        if (ok) {
+            stacks[i].depth = depth;
+            stacks[i].clamped = clamped;
+            memcpy(stacks[i].ops, p, depth * sizeof(stacks[i].ops[0]));
+            p += depth * sizeof(stacks[i].ops[0]);
+        }
+    }
+    if (! ok || (size_t)(end - p) < sizeof(n)) {
+        clc::Log::warn("ocher.pagination", "%s is truncated", path);
+        return false;
+    }
+    memcpy(&n, p, sizeof(n));
+    p += sizeof(n);
+    const size_t pageSize = 3 * sizeof(uint32_t);
+    if ((size_t)(end - p) % pageSize != 0 || n != (size_t)(end - p) / pageSize) {
+        clc::Log::warn("ocher.pagination", "%s is truncated", path);
+        return false;
+    }
+
+    flush();
+    uint32_t prev[2] = { 0, 0 };
+    for (unsigned int i = 0; i < n; ++i) {
+        uint32_t fields[3];
+        memcpy(fields, p, sizeof(fields));
+        p += sizeof(fields);
+        if (fields[2] >= stacks.size()) {
+            clc::Log::warn("ocher.pagination", "%s is corrupt", path);
+            flush();
+            return false;
+        }
+        // set() requires the breaks in order.
+        if (fields[0] < prev[0] || (fields[0] == prev[0] && fields[1] < prev[1])) {
+            clc::Log::warn("ocher.pagination", "%s has page %u out of order", path, i);
+            flush();
+            return false;
+        }
+        set(i, fields[0], fields[1], stacks[fields[2]]);
+        prev[0] = fields[0];
+        prev[1] = fields[1];
+    }
+    clc::Log::info("ocher.pagination", "loaded %u page breaks from %s", n, path);
+    return true;
+}
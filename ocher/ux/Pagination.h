@@ -1,18 +1,58 @@
 #ifndef OCHER_PAGINATION_H
 #define OCHER_PAGINATION_H
 
-#include "clc/data/List.h"
+#include <stdint.h>
+#include <vector>
+
+#include "clc/data/Buffer.h"
 
 
 /**
- * Stores a mapping from a page number to offsets within the Layout.
+ * Stores a mapping from a page number to offsets within the Layout, and back.
+ *
+ * The table is compact (about 3 bytes per page) so that it stays in cache for long books:  pages
+ * are grouped in blocks, each holding its first page's offsets and the rest as deltas from
+ * those, bit-packed at the narrowest widths the block needs.  Lookup by page is constant time;
+ * by offset, a binary search.
+ *
+ * Each break also records the attributes open there (see AttrStack), so that any page can be
+ * rendered without replaying the layout before it.  A book has few distinct stacks, so they are
+ * stored once and the entries index them.
  *
- * @todo  persist pagination for faster random access (per everything that might affect layout:
- * ocher version, book modification time, layout prefs, ...)
+ * The mapping can be persisted, so that reopening a book restores its pages without
+ * repaginating.  The saved table is only valid for the same book, layout and rendering
+ * parameters, so it is stored with a key describing all of them (see Renderer::layoutKey) and is
+ * discarded on load if the key differs.
  */
 class Pagination
 {
 public:
+    /**
+     * The attributes open at a page break:  the ops that pushed them, outermost first.
+     */
+    struct AttrStack {
+        AttrStack() : depth(0), clamped(0) {}
+        bool operator==(const AttrStack &other) const;
+
+        /**
+         * The most attributes open at once.  Renderers hold as many (see Renderer::pushAttrs);
+         * pushes past them are only counted, as clamped.
+         */
+        static const unsigned int maxDepth = 9;
+        unsigned int depth;
+        unsigned int clamped;  ///< pushes past maxDepth, whose pops are skipped
+        uint16_t ops[maxDepth];  ///< Layout bytecode
+    };
+
+    /**
+     * Where a page ends (and the next starts), as get returns.
+     */
+    struct Break {
+        unsigned int layoutOffset;
+        unsigned int strOffset;
+        AttrStack attrs;
+    };
+
     Pagination();
     ~Pagination();
 
@@ -25,22 +65,74 @@ public:
      * Sets a mapping from a page to offsets within the Layout.  Setting a page invalidates all
      * subsequent pages.
      */
-    void set(unsigned int page, unsigned int layoutOffset, unsigned int strOffset /* TODO attrs */);
+    void set(unsigned int page, unsigned int layoutOffset, unsigned int strOffset,
+            const AttrStack &attrs);
+
+    bool get(unsigned int page, unsigned int* layoutOffset, unsigned int* strOffset,
+            AttrStack *attrs=0);
 
-    bool get(unsigned int page, unsigned int* layoutOffset, unsigned int* strOffset /* TODO attrs */);
+    /**
+     * @return The page that the offsets fall on, for example of a bookmark or search hit.  Past
+     *      the last break, that is numPages(), which is only the last page once pagination is
+     *      complete.
+     */
+    unsigned int find(unsigned int layoutOffset, unsigned int strOffset) const;
+
+    /**
+     * @return The number of page breaks (one less than the number of pages, when complete).
+     */
+    unsigned int numPages() const { return m_numPages; }
+
+    /**
+     * Writes the page table, tagged with key.  Failure is logged and otherwise ignored; it only
+     * costs repaginating next time.
+     */
+    void save(const char *path, const clc::Buffer &key);
+
+    /**
+     * Replaces the page table with the one saved at path, if it was saved with the same key.
+     * @return true if loaded
+     */
+    bool load(const char *path, const clc::Buffer &key);
 
 protected:
-    struct PageMapping
+    /**
+     * pagesPerBlock consecutive breaks.  Entry i of the block is packed at bit
+     * bit + i*(layoutBits+strBits+attrBits):  its layoutOffset less the block's, its strOffset,
+     * then its index into m_attrStacks.
+     */
+    struct Block
     {
         /** @todo to handle large epubs on small machines, may need to break up
          * the layout per spine index */
-        //unsigned int spineIndex;
+        uint32_t layoutOffset;  ///< of the first break in the block
+        uint32_t bit;  ///< where the entries start in m_bits; word aligned
+        uint8_t layoutBits;
+        uint8_t strBits;
+        uint8_t attrBits;
+        unsigned int entryBits() const { return layoutBits + strBits + attrBits; }
+    };
+    /**
+     * A break, unpacked.
+     */
+    struct Entry {
         unsigned int layoutOffset;
         unsigned int strOffset;
-        /* TODO attrs */
+        unsigned int attrs;  ///< index into m_attrStacks
     };
-    static const unsigned int pagesPerChunk = 100;
-    clc::List m_pages;
+    static const unsigned int pagesPerBlock = 64;
+    static const char magic[8];
+
+    uint32_t readBits(unsigned int bit, unsigned int width) const;
+    void writeBits(unsigned int bit, unsigned int width, uint32_t v);
+    void entry(unsigned int pageNum, Entry *e) const;
+    void pack(Block &b, unsigned int i, const Entry &e);
+    static unsigned int bitsFor(unsigned int v);
+    unsigned int intern(const AttrStack &attrs);
+
+    std::vector<Block> m_blocks;
+    std::vector<uint32_t> m_bits;
+    std::vector<AttrStack> m_attrStacks;  ///< distinct; the first is empty
     unsigned int m_numPages;
 };
 
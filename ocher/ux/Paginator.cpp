@@ -0,0 +1,321 @@
+#include "clc/crypto/MurmurHash2.h"
+#include "clc/os/Stopwatch.h"
+#include "clc/os/ThreadPool.h"
+#include "clc/support/Logger.h"
+
+#include "ocher/settings/Settings.h"
+#include "ocher/ux/Paginator.h"
+#include "ocher/ux/Renderer.h"
+
+
+Paginator::Paginator(Renderer &renderer) :
+    clc::Thread("paginator"),
+    m_renderer(renderer),
+    m_pages(1),
+    m_estimate(0),
+    m_done(false),
+    m_stop(false)
+{
+}
+
+Paginator::~Paginator()
+{
+    stop();
+}
+
+void Paginator::paginate(const char *cacheStem, const clc::Buffer &bookKey)
+{
+    stop();
+    m_cacheStem = cacheStem;
+    m_bookKey = bookKey;
+    repaginate();
+}
+
+void Paginator::repaginate()
+{
+    stop();
+    cacheFile(m_renderer, m_cachePath, m_key);
+    m_speculative.clear();
+    for (unsigned int i = 0; i < Settings::maxRecentFontPoints; ++i) {
+        const int points = settings.recentFontPoints[i];
+        if (points && points != settings.fontPoints)
+            m_speculative.push_back(points);
+    }
+
+    int pages = m_renderer.loadPagination(m_cachePath.c_str(), m_key);
+    m_monitor.lock();
+    m_stop = false;
+    m_done = pages > 0;
+    m_pages = m_done ? pages : 1;
+    m_estimate = m_done ? pages : 0;
+    m_monitor.notifyAll();
+    m_monitor.unlock();
+    if (m_done && m_speculative.empty())
+        return;
+
+#ifndef SINGLE_THREADED
+    try {
+        start();
+        return;
+    } catch (...) {
+        clc::Log::warn("ocher.pagination", "no paginator thread; paginating first");
+    }
+#endif
+    // Not worth the wait for other sizes.
+    if (! m_done)
+        paginateBook();
+}
+
+void Paginator::cacheFile(Renderer &renderer, clc::Buffer &path, clc::Buffer &key)
+{
+    key = m_bookKey;
+    renderer.layoutKey(key);
+    path.format("%s-%08x.pages", m_cacheStem.c_str(), clc::hash(key.data(), key.size()));
+}
+
+void Paginator::stop()
+{
+    m_monitor.lock();
+    m_stop = true;
+    m_monitor.notifyAll();
+    m_monitor.unlock();
+    join();
+}
+
+bool Paginator::waitFor(unsigned int pageNum)
+{
+    m_monitor.lock();
+    while (pageNum >= m_pages && ! m_done && ! m_stop)
+        m_monitor.wait();
+    bool known = pageNum < m_pages;
+    m_monitor.unlock();
+    return known;
+}
+
+unsigned int Paginator::pages(bool *done)
+{
+    m_monitor.lock();
+    unsigned int pages = m_pages;
+    *done = m_done;
+    m_monitor.unlock();
+    return pages;
+}
+
+unsigned int Paginator::estimate()
+{
+    m_monitor.lock();
+    unsigned int estimate = m_estimate;
+    m_monitor.unlock();
+    return estimate;
+}
+
+void Paginator::publish(unsigned int pageNum, const std::vector<Pagination::Break> &breaks,
+        bool done)
+{
+    m_renderer.setPageBreaks(pageNum, breaks);
+    const unsigned int pages = pageNum + breaks.size() + 1;
+    unsigned int estimate = pages;
+    if (! done && ! breaks.empty()) {
+        estimate = m_estimator.estimate(pages - 1,
+                m_estimator.bytesBefore(breaks.back().layoutOffset, breaks.back().strOffset));
+    }
+
+    m_monitor.lock();
+    m_pages = pages;
+    m_estimate = estimate > pages ? estimate : pages;
+    m_done = done;
+    m_monitor.notifyAll();
+    m_monitor.unlock();
+    m_renderer.paginated();
+}
+
+bool Paginator::stopping()
+{
+    m_monitor.lock();
+    bool stop = m_stop;
+    m_monitor.unlock();
+    return stop;
+}
+
+/**
+ * Paginates a chapter per item, each worker with its own clone of the renderer.  Each chapter
+ * is published once all before it are, so that pages are known in order.
+ */
+class ChapterJob : public clc::ThreadPool::Job
+{
+public:
+    ChapterJob(Paginator &paginator, const std::vector<unsigned int> &chapters,
+            unsigned int nWorkers, Renderer *first) :
+        m_paginator(paginator),
+        m_chapters(chapters),
+        m_workers(nWorkers),
+        m_breaks(chapters.size()),
+        m_results(chapters.size()),
+        m_finished(chapters.size()),
+        m_published(0),
+        m_pages(0)
+    {
+        m_workers[0] = first;
+    }
+
+    ~ChapterJob()
+    {
+        for (unsigned int i = 0; i < m_workers.size(); ++i)
+            delete m_workers[i];
+    }
+
+    void run(unsigned int worker, unsigned int item)
+    {
+        // Once stopped (or failed), later chapters are left to Paginator::run.
+        if (m_paginator.stopping())
+            return;
+        Renderer *r = m_workers[worker];
+        if (! r) {
+            r = m_workers[worker] = m_paginator.m_renderer.clone();
+            if (! r) {
+                clc::Log::warn("ocher.pagination", "no renderer for worker %u", worker);
+                return;
+            }
+        }
+
+        const unsigned int end = item + 1 < m_chapters.size() ? m_chapters[item+1] :
+            r->layout().size();
+        std::vector<Pagination::Break> breaks;
+        int result = r->paginateChapter(m_chapters[item], end, breaks);
+        clc::Log::debug("ocher.pagination", "worker %u paginated chapter %u: %u page breaks",
+                worker, item, (unsigned int)breaks.size());
+
+        clc::Locker locker(m_lock);
+        m_breaks[item].swap(breaks);
+        m_results[item] = result;
+        m_finished[item] = true;
+        while (m_published < m_chapters.size() && m_finished[m_published]) {
+            m_paginator.publish(m_pages, m_breaks[m_published], m_results[m_published] != 0);
+            m_pages += m_breaks[m_published].size();
+            std::vector<Pagination::Break>().swap(m_breaks[m_published]);
+            ++m_published;
+        }
+    }
+
+protected:
+    Paginator &m_paginator;
+    const std::vector<unsigned int> &m_chapters;
+    std::vector<Renderer*> m_workers;  ///< clones, each made by its worker on first use
+    clc::Lock m_lock;  ///< guards all below
+    std::vector<std::vector<Pagination::Break> > m_breaks;  ///< by chapter, until published
+    std::vector<int> m_results;  ///< by chapter
+    std::vector<bool> m_finished;  ///< by chapter
+    unsigned int m_published;  ///< chapters
+    unsigned int m_pages;  ///< page breaks published
+};
+
+void Paginator::run()
+{
+    bool done;
+    pages(&done);
+    if (! done && paginateBook() != 1)
+        return;
+    speculate();
+}
+
+int Paginator::paginateBook()
+{
+    clc::Stopwatch sw;
+    m_estimator.scan(m_renderer.layout());
+    m_estimator.sample(m_renderer);
+    unsigned int estimate = m_estimator.estimate(0, 0);
+    m_monitor.lock();
+    m_estimate = estimate;
+    m_monitor.unlock();
+    clc::Log::info("ocher.pagination", "estimated %u pages in %llu us", estimate,
+            (unsigned long long)sw.elapsedUSec());
+
+    // Chapters start on new pages, so paginate independently.
+    const std::vector<unsigned int> chapters = m_estimator.chapters();
+    clc::ThreadPool pool;
+    Renderer *first = chapters.size() > 1 && pool.size() > 1 ? m_renderer.clone() : 0;
+    if (first) {
+        ChapterJob job(*this, chapters, pool.size(), first);
+        pool.run(job, chapters.size());
+        clc::Log::info("ocher.pagination", "paginated %u chapters on %u workers in %llu us",
+                (unsigned int)chapters.size(), pool.size(), (unsigned long long)sw.elapsedUSec());
+    }
+
+    int r = 0;
+    bool done;
+    unsigned int pageNum = pages(&done) - 1;
+    if (done) {
+        r = 1;
+    } else for ( ; ; ++pageNum) {
+        // Sequentially, or what the chapter jobs left undone.
+        if (stopping()) {
+            clc::Log::info("ocher.pagination", "cancelled at page %u", pageNum);
+            return -1;
+        }
+
+        // Each page is a separate render, so that pages being read take turns with pagination.
+        r = m_renderer.render(pageNum, false);
+        unsigned int layoutOffset, strOffset;
+        if (r == 0 && m_renderer.pageBreak(pageNum, &layoutOffset, &strOffset))
+            estimate = m_estimator.estimate(pageNum + 1,
+                    m_estimator.bytesBefore(layoutOffset, strOffset));
+
+        m_monitor.lock();
+        if (r == 0) {
+            m_pages = pageNum + 2;
+            m_estimate = estimate > m_pages ? estimate : m_pages;
+        } else {
+            // Ended with this page (or, failing, before it).
+            m_pages = r > 0 ? pageNum + 1 : pageNum;
+            m_estimate = m_pages;
+            m_done = true;
+        }
+        m_monitor.notifyAll();
+        m_monitor.unlock();
+        m_renderer.paginated();
+        if (r != 0)
+            break;
+        clc::Log::debug("ocher.pagination", "paginated page %u", pageNum);
+    }
+    clc::Log::info("ocher.pagination", "paginated %u pages in %llu us", pages(&done),
+            (unsigned long long)sw.elapsedUSec());
+
+    if (r == 1)
+        m_renderer.savePagination(m_cachePath.c_str(), m_key);
+    return r;
+}
+
+void Paginator::speculate()
+{
+    for (unsigned int i = 0; i < m_speculative.size(); ++i) {
+        Renderer *r = m_renderer.clone();
+        if (! r || ! r->setFontPoints(m_speculative[i])) {
+            delete r;
+            return;
+        }
+        clc::Buffer path;
+        clc::Buffer key;
+        cacheFile(*r, path, key);
+        if (r->loadPagination(path.c_str(), key) < 0) {
+            // A page at a time, to stop promptly when the reader changes size or book.
+            clc::Stopwatch sw;
+            int result = 0;
+            unsigned int pageNum;
+            for (pageNum = 0; result == 0; ++pageNum) {
+                if (stopping()) {
+                    clc::Log::info("ocher.pagination", "cancelled at %d points, page %u",
+                            m_speculative[i], pageNum);
+                    delete r;
+                    return;
+                }
+                result = r->render(pageNum, false);
+            }
+            if (result == 1) {
+                r->savePagination(path.c_str(), key);
+                clc::Log::info("ocher.pagination", "paginated %u pages at %d points in %llu us",
+                        pageNum, m_speculative[i], (unsigned long long)sw.elapsedUSec());
+            }
+        }
+        delete r;
+    }
+}
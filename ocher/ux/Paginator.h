@@ -0,0 +1,116 @@
+#ifndef OCHER_UX_PAGINATOR_H
+#define OCHER_UX_PAGINATOR_H
+
+#include <vector>
+
+#include "clc/data/Buffer.h"
+#include "clc/os/Monitor.h"
+#include "clc/os/Thread.h"
+
+#include "ocher/ux/PageEstimate.h"
+#include "ocher/ux/Pagination.h"
+
+class Renderer;
+
+
+/**
+ * Paginates a book on a background thread, so that reading can start at once.  Page breaks are
+ * published into the Renderer's Pagination as they are found; a page can be rendered once
+ * waitFor says it is known.  Meanwhile the number of pages is estimated (see PageEstimate).
+ *
+ * As chapters start new pages, a book of several chapters is paginated a chapter per job on a
+ * clc::ThreadPool, each worker with a clone of the renderer (see Renderer::clone).  Otherwise,
+ * pages are paginated one at a time on the renderer itself.
+ *
+ * Paginations are persisted per book and layout key, so several font sizes each have their own.
+ * Once the book is paginated, the thread goes on to paginate it at the other font sizes used
+ * lately (see Settings::recentFontPoints), so that changing back to one is instant.
+ */
+class Paginator : public clc::Thread
+{
+public:
+    Paginator(Renderer &renderer);
+    ~Paginator();
+
+    /**
+     * Restores the book's persisted pagination if it matches its key, and otherwise starts
+     * paginating from the first page (saving the result when complete).  Cancels any
+     * pagination under way.
+     * @param cacheStem  Where to persist paginations, less a suffix for the layout key.
+     * @param bookKey  Identifies the book and its layout; the renderer's Renderer::layoutKey
+     *      is appended.
+     */
+    void paginate(const char *cacheStem, const clc::Buffer &bookKey);
+
+    /**
+     * As paginate, for the same book, after changing anything that affects layout.  Stop
+     * before changing it.
+     */
+    void repaginate();
+
+    /**
+     * Cancels the pagination under way, if any, and waits for it to stop.
+     */
+    void stop();
+
+    /**
+     * Waits until the page can be rendered, or is known to be past the end of the book.
+     * @return true if the page exists
+     */
+    bool waitFor(unsigned int pageNum);
+
+    /**
+     * @param done  Set if the count is final, rather than a lower bound.
+     * @return Pages known so far.
+     */
+    unsigned int pages(bool *done);
+
+    /**
+     * @return Estimated number of pages (exact once done), or 0 if not yet estimated.
+     */
+    unsigned int estimate();
+
+protected:
+    friend class ChapterJob;
+
+    void run();
+
+    /**
+     * Paginates the book with m_renderer.
+     * @return As Renderer::render:  1 if complete, or -1 if failed or cancelled.
+     */
+    int paginateBook();
+
+    /**
+     * Paginates the book at each of m_speculative's font sizes not persisted yet, on a clone of
+     * the renderer, and persists the results.
+     */
+    void speculate();
+
+    /**
+     * Where the renderer's pagination of the book is persisted, and its key.
+     */
+    void cacheFile(Renderer &renderer, clc::Buffer &path, clc::Buffer &key);
+
+    /**
+     * Publishes page breaks from pageNum on.
+     * @param done  The breaks run to the end of the book.
+     */
+    void publish(unsigned int pageNum, const std::vector<Pagination::Break> &breaks, bool done);
+    bool stopping();
+
+    Renderer &m_renderer;
+    clc::Buffer m_cacheStem;
+    clc::Buffer m_bookKey;
+    clc::Buffer m_cachePath;
+    clc::Buffer m_key;
+    std::vector<int> m_speculative;  ///< font sizes to paginate at once idle
+    PageEstimate m_estimator;  ///< used by the thread (and its chapter jobs, in turn)
+    clc::Monitor m_monitor;  ///< guards all below
+    unsigned int m_pages;  ///< pages whose start is known
+    unsigned int m_estimate;
+    bool m_done;
+    bool m_stop;
+};
+
+#endif
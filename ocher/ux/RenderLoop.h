@@ -0,0 +1,248 @@
+#ifndef OCHER_UX_RENDERLOOP_H
+#define OCHER_UX_RENDERLOOP_H
+
+/** @file The layout bytecode interpreter shared by all renderers.
+ *
+ * Include only from a renderer's implementation file; see Renderer::renderPage.
+ */
+
+#include <stdint.h>
+
+#include "clc/support/Debug.h"
+#include "clc/support/Logger.h"
+
+#include "ocher/fmt/Layout.h"
+#include "ocher/ux/Renderer.h"
+
+
+template<class Policy, bool doBlit>
+int Renderer::renderPage(unsigned int pageNum)
+{
+    unsigned int layoutOffset;
+    unsigned int strOffset;
+    Pagination::AttrStack attrs;
+    if (!pageNum) {
+        layoutOffset = 0;
+        strOffset = 0;
+    } else if (! m_pagination.get(pageNum-1, &layoutOffset, &strOffset, &attrs)) {
+        // Previous page not already paginated?
+        // Perhaps at end of book?
+        return -1;
+    }
+    // Whatever was rendered last, the page starts with the attributes open at its break.
+    setAttrStack(attrs);
+
+    int r = renderFrom<Policy, doBlit>(&layoutOffset, &strOffset);
+    if (r == 0 && !doBlit) {
+        getAttrStack(&attrs);
+        m_pagination.set(pageNum, layoutOffset, strOffset, attrs);
+    }
+    return r;
+}
+
+template<class Policy>
+int Renderer::renderAtFrom(Pagination::Break *start)
+{
+    setAttrStack(start->attrs);
+    int r = renderFrom<Policy, true>(&start->layoutOffset, &start->strOffset);
+    if (r == 0)
+        getAttrStack(&start->attrs);
+    return r;
+}
+
+template<class Policy>
+int Renderer::measureFrom(unsigned int *layoutOffset, unsigned int *strOffset)
+{
+    setAttrStack(Pagination::AttrStack());
+    return renderFrom<Policy, false>(layoutOffset, strOffset);
+}
+
+template<class Policy>
+void Renderer::lineStarts(const Pagination::Break &from, const Pagination::Break &to,
+        std::vector<Pagination::Break> &lines)
+{
+    // A page of one line ends where the next line starts.
+    setAttrStack(from.attrs);
+    Pagination::Break b = from;
+    m_lineLimit = 1;
+    while (before(b, to)) {
+        lines.push_back(b);
+        if (renderFrom<Policy, false>(&b.layoutOffset, &b.strOffset) != 0 ||
+                ! before(lines.back(), b))
+            break;
+        getAttrStack(&b.attrs);
+    }
+    m_lineLimit = 0;
+}
+
+template<class Policy>
+int Renderer::pageBeforeFrom(Pagination::Break *start)
+{
+    if (m_restarts.empty())
+        findRestarts();
+    const Pagination::Break to = *start;
+    if (! before(m_restarts[0].at, to))
+        return -1;
+
+    // Lines wrap forward only, so the lines before the position are found from a restart
+    // before it, going back a restart at a time until they fill a page.
+    unsigned int ri = m_restarts.size() - 1;
+    while (! before(m_restarts[ri].at, to))
+        --ri;
+    std::vector<Pagination::Break> lines;
+    lineStarts<Policy>(m_restarts[ri].at, to, lines);
+    Pagination::Break end;
+    for (;;) {
+        end = m_restarts[ri].at;
+        setAttrStack(end.attrs);
+        if (renderFrom<Policy, false>(&end.layoutOffset, &end.strOffset) == 0 &&
+                before(end, to))
+            break;
+        if (m_restarts[ri].chapter) {
+            // The chapter's first page.
+            *start = m_restarts[ri].at;
+            return 0;
+        }
+        --ri;
+        std::vector<Pagination::Break> more;
+        lineStarts<Policy>(m_restarts[ri].at, m_restarts[ri+1].at, more);
+        lines.insert(lines.begin(), more.begin(), more.end());
+    }
+
+    // As many lines as fit on a page, ending at the position.
+    unsigned int fit = 0;
+    while (fit < lines.size() && before(lines[fit], end))
+        ++fit;
+    unsigned int s = lines.size() - fit;
+    // Lines wrapped from a page's start may differ from those wrapped through it (as where
+    // a line would start with a hanging space), so check, preferring the fullest page that
+    // ends at the position.
+    for ( ; s + 1 < lines.size(); ++s) {
+        end = lines[s];
+        setAttrStack(end.attrs);
+        if (renderFrom<Policy, false>(&end.layoutOffset, &end.strOffset) != 0 ||
+                ! before(end, to))
+            break;
+    }
+    while (s > 0) {
+        end = lines[s-1];
+        setAttrStack(end.attrs);
+        if (renderFrom<Policy, false>(&end.layoutOffset, &end.strOffset) != 0 ||
+                before(end, to) || before(to, end))
+            break;
+        --s;
+    }
+    *start = lines[s];
+    return 0;
+}
+
+template<class Policy>
+int Renderer::paginateChapterFrom(unsigned int layoutOffset, unsigned int end,
+        std::vector<Pagination::Break> &breaks)
+{
+    setAttrStack(Pagination::AttrStack());
+    Pagination::Break b;
+    b.layoutOffset = layoutOffset;
+    b.strOffset = 0;
+    for (;;) {
+        int r = renderFrom<Policy, false>(&b.layoutOffset, &b.strOffset);
+        if (r != 0)
+            return r;
+        getAttrStack(&b.attrs);
+        breaks.push_back(b);
+        if (b.layoutOffset >= end)
+            return 0;
+    }
+}
+
+template<class Policy, bool doBlit>
+int Renderer::renderFrom(unsigned int *layoutOffset, unsigned int *breakOffset)
+{
+    Policy& r = static_cast<Policy&>(*this);
+    unsigned int strOffset = *breakOffset;
+    bool blank = true;  // nothing shown yet, so a forced page break is moot
+
+    r.template beginPage<doBlit>();
+
+    const unsigned int N = m_layout.size();
+    const char *raw = m_layout.data();
+    ASSERT(*layoutOffset < N);
+    for (unsigned int i = *layoutOffset; i < N; ) {
+        ASSERT(i+2 <= N);
+        uint16_t code = *(uint16_t*)(raw+i);
+        i += 2;
+
+        unsigned int opType = (code>>12)&0xf;
+        unsigned int op = (code>>8)&0xf;
+        unsigned int arg = code & 0xff;
+        switch (opType) {
+            case Layout::OpPushTextAttr:
+            case Layout::OpPushLineAttr:
+                // Line attributes are popped by CmdPopAttr, as text attributes are.
+                if (pushAttr(code))
+                    r.template applyAttrs<doBlit>(1);
+                break;
+            case Layout::OpCmd:
+                switch (op) {
+                    case Layout::CmdPopAttr:
+                        if (arg == 0)
+                            arg = 1;
+                        while (arg--) {
+                            if (popAttrs())
+                                r.template applyAttrs<doBlit>(-1);
+                        }
+                        break;
+                    case Layout::CmdOutputStr: {
+                        ASSERT(i + sizeof(clc::Buffer*) + sizeof(uint8_t*) <= N);
+                        clc::Buffer *str = *(clc::Buffer**)(raw+i);
+                        const uint8_t *breaks = *(uint8_t**)(raw+i+sizeof(clc::Buffer*));
+                        ASSERT(strOffset <= str->size());
+                        if (blank)
+                            blank = isBlank(str, strOffset);
+                        int b = r.template outputWrapped<doBlit>(str, breaks, strOffset);
+                        strOffset = 0;
+                        if (b >= 0) {
+                            *layoutOffset = i-2;
+                            *breakOffset = b;
+                            skipToForcedBreak(layoutOffset, breakOffset);
+                            r.template endPage<doBlit>();
+                            return 0;
+                        }
+                        i += sizeof(clc::Buffer*) + sizeof(uint8_t*);
+                        break;
+                    }
+                    case Layout::CmdForcePage:
+                        // The next page starts here, so this is skipped at the top of a page.
+                        if (! blank) {
+                            *layoutOffset = i-2;
+                            *breakOffset = 0;
+                            r.template endPage<doBlit>();
+                            return 0;
+                        }
+                        m_attrsClamped = 0;
+                        while (ai > 1) {
+                            popAttrs();
+                            r.template applyAttrs<doBlit>(-1);
+                        }
+                        break;
+                    default:
+                        clc::Log::error("ocher.render", "unknown OpCmd");
+                        ASSERT(0);
+                        break;
+                }
+                break;
+            case Layout::OpSpacing:
+                break;
+            case Layout::OpImage:
+                break;
+            default:
+                clc::Log::error("ocher.render", "unknown op type");
+                ASSERT(0);
+                break;
+        };
+    }
+    r.template endPage<doBlit>();
+    return 1;
+}
+
+#endif
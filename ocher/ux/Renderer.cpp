@@ -1,10 +1,294 @@
+#include <ctype.h>
+
+#include "clc/support/Debug.h"
+#include "clc/support/Logger.h"
+
+#include "ocher/fmt/Layout.h"
 #include "ocher/ux/Renderer.h"
 
 
-Renderer::Renderer()
+Renderer::Renderer() :
+    m_lineLimit(0),
+    ai(1),
+    m_attrsClamped(0)
 {
 }
 
+int Renderer::loadPagination(const char *path, const clc::Buffer &key)
+{
+    clc::Locker locker(m_renderLock);
+    if (! m_pagination.load(path, key)) {
+        m_pagination.flush();
+        return -1;
+    }
+    // The last page ends with the layout rather than a break.
+    return m_pagination.numPages() + 1;
+}
+
+void Renderer::savePagination(const char *path, const clc::Buffer &key)
+{
+    clc::Locker locker(m_renderLock);
+    m_pagination.save(path, key);
+}
+
+bool Renderer::pageBreak(unsigned int pageNum, unsigned int *layoutOffset, unsigned int *strOffset,
+        Pagination::AttrStack *attrs)
+{
+    clc::Locker locker(m_renderLock);
+    return m_pagination.get(pageNum, layoutOffset, strOffset, attrs);
+}
+
+unsigned int Renderer::pageOf(unsigned int layoutOffset, unsigned int strOffset)
+{
+    clc::Locker locker(m_renderLock);
+    return m_pagination.find(layoutOffset, strOffset);
+}
+
+void Renderer::setPageBreaks(unsigned int pageNum, const std::vector<Pagination::Break> &breaks)
+{
+    clc::Locker locker(m_renderLock);
+    for (unsigned int i = 0; i < breaks.size(); ++i)
+        m_pagination.set(pageNum + i, breaks[i].layoutOffset, breaks[i].strOffset, breaks[i].attrs);
+}
+
+bool Renderer::isBlank(const clc::Buffer *str, unsigned int strOffset)
+{
+    const char *p = str->data();
+    for (unsigned int i = strOffset; i < str->size(); ++i) {
+        if (! isspace((unsigned char)p[i]))
+            return false;
+    }
+    return true;
+}
+
+void Renderer::skipToForcedBreak(unsigned int *layoutOffset, unsigned int *strOffset) const
+{
+    const unsigned int N = m_layout.size();
+    const char *raw = m_layout.data();
+    unsigned int from = *strOffset;
+    for (unsigned int i = *layoutOffset; i < N; ) {
+        uint16_t code = *(uint16_t*)(raw+i);
+        unsigned int opType = (code>>12)&0xf;
+        unsigned int op = (code>>8)&0xf;
+        if (opType == Layout::OpPushTextAttr || opType == Layout::OpPushLineAttr) {
+            // Dropped along with the text; the forced break resets attributes anyway.
+            i += 2;
+        } else if (opType == Layout::OpCmd && op == Layout::CmdPopAttr) {
+            i += 2;
+        } else if (opType == Layout::OpCmd && op == Layout::CmdOutputStr) {
+            if (! isBlank(*(clc::Buffer**)(raw+i+2), from))
+                return;
+            from = 0;
+            i += 2 + sizeof(clc::Buffer*) + sizeof(uint8_t*);
+        } else if (opType == Layout::OpCmd && op == Layout::CmdForcePage) {
+            *layoutOffset = i;
+            *strOffset = 0;
+            return;
+        } else {
+            return;
+        }
+    }
+}
+
+void Renderer::findRestarts()
+{
+    m_restarts.clear();
+    Restart restart;
+    restart.at.layoutOffset = 0;
+    restart.at.strOffset = 0;
+    restart.chapter = true;
+    m_restarts.push_back(restart);
+
+    const unsigned int N = m_layout.size();
+    const char *raw = m_layout.data();
+    Pagination::AttrStack &attrs = restart.at.attrs;
+    bool paragraph = true;  // the next string starts a line
+    bool blank = true;  // since the chapter started
+    unsigned int bytes = 0;  // since the last restart
+    for (unsigned int i = 0; i < N; ) {
+        uint16_t code = *(uint16_t*)(raw+i);
+        unsigned int opType = (code>>12)&0xf;
+        unsigned int op = (code>>8)&0xf;
+        unsigned int arg = code & 0xff;
+        if (opType == Layout::OpPushTextAttr || opType == Layout::OpPushLineAttr) {
+            // As pushAttrs.
+            if (attrs.depth < Pagination::AttrStack::maxDepth)
+                attrs.ops[attrs.depth++] = code;
+            else
+                ++attrs.clamped;
+            i += 2;
+        } else if (opType == Layout::OpCmd && op == Layout::CmdPopAttr) {
+            for (unsigned int n = arg ? arg : 1; n; --n) {
+                if (attrs.clamped)
+                    --attrs.clamped;
+                else if (attrs.depth)
+                    --attrs.depth;
+            }
+            i += 2;
+        } else if (opType == Layout::OpCmd && op == Layout::CmdOutputStr) {
+            const clc::Buffer *str = *(clc::Buffer**)(raw+i+2);
+            const char *p = str->data();
+            const unsigned int size = str->size();
+            // A line starts after each newline, whether between strings or within one (as in
+            // plain text, which is laid out in arbitrary chunks).
+            restart.at.layoutOffset = i;
+            restart.chapter = false;
+            for (unsigned int k = 0; k < size; ++k) {
+                if ((k == 0 && paragraph) || (k > 0 && p[k-1] == '\n')) {
+                    if (bytes >= restartBytes) {
+                        restart.at.strOffset = k;
+                        m_restarts.push_back(restart);
+                        bytes = 0;
+                    }
+                }
+                ++bytes;
+            }
+            restart.at.strOffset = 0;
+            if (size) {
+                paragraph = p[size-1] == '\n';
+                if (blank)
+                    blank = isBlank(str, 0);
+            }
+            i += 2 + sizeof(clc::Buffer*) + sizeof(uint8_t*);
+        } else if (opType == Layout::OpCmd && op == Layout::CmdForcePage) {
+            // As Renderer::renderFrom, which skips a forced page break that only follows blank
+            // text:  the chapter starts at the first of them.
+            attrs.depth = 0;
+            attrs.clamped = 0;
+            if (! blank || ! m_restarts.back().chapter) {
+                restart.at.layoutOffset = i;
+                restart.chapter = true;
+                m_restarts.push_back(restart);
+            }
+            paragraph = true;
+            blank = true;
+            bytes = 0;
+            i += 2;
+        } else {
+            i += 2;
+        }
+    }
+    clc::Log::debug("ocher.render", "%u restarts", (unsigned int)m_restarts.size());
+}
+
+void Renderer::canonical(unsigned int *layoutOffset, unsigned int *strOffset) const
+{
+    const unsigned int N = m_layout.size();
+    const char *raw = m_layout.data();
+    unsigned int i = *layoutOffset;
+    if (i + 2 > N || *strOffset == 0)
+        return;
+    uint16_t code = *(uint16_t*)(raw+i);
+    if (((code>>12)&0xf) != Layout::OpCmd || ((code>>8)&0xf) != Layout::CmdOutputStr ||
+            *strOffset < (*(clc::Buffer**)(raw+i+2))->size())
+        return;
+    // At the end of the string:  the same place as the next string or page break.
+    for (i += 2 + sizeof(clc::Buffer*) + sizeof(uint8_t*); i < N; i += 2) {
+        code = *(uint16_t*)(raw+i);
+        if (((code>>12)&0xf) == Layout::OpCmd && (((code>>8)&0xf) == Layout::CmdOutputStr ||
+                    ((code>>8)&0xf) == Layout::CmdForcePage))
+            break;
+    }
+    *layoutOffset = i;
+    *strOffset = 0;
+}
+
+bool Renderer::before(const Pagination::Break &a, const Pagination::Break &b) const
+{
+    unsigned int al = a.layoutOffset, as = a.strOffset;
+    unsigned int bl = b.layoutOffset, bs = b.strOffset;
+    canonical(&al, &as);
+    canonical(&bl, &bs);
+    return al < bl || (al == bl && as < bs);
+}
+
+bool Renderer::pushAttrs()
+{
+    if (ai+1 >= maxAttrs) {
+        // Valid, if unlikely, markup nests deeper:  keep the outermost attributes.
+        ++m_attrsClamped;
+        return false;
+    }
+    a[ai+1] = a[ai];
+    ai++;
+    return true;
+}
+
+bool Renderer::popAttrs()
+{
+    if (m_attrsClamped) {
+        --m_attrsClamped;
+        return false;
+    }
+    ASSERT(ai > 1);
+    if (ai <= 1)
+        return false;
+    ai--;
+    return true;
+}
+
+bool Renderer::pushAttr(uint16_t code)
+{
+    unsigned int opType = (code>>12)&0xf;
+    unsigned int op = (code>>8)&0xf;
+    if (! pushAttrs())
+        return false;
+    m_attrOps[ai] = code;
+    if (opType == Layout::OpPushTextAttr) {
+        switch (op) {
+            case Layout::AttrBold:
+                a[ai].b = 1;
+                break;
+            case Layout::AttrUnderline:
+                a[ai].ul = 1;
+                break;
+            case Layout::AttrItalics:
+                a[ai].em = 1;
+                break;
+            case Layout::AttrSizeRel:
+                break;
+            case Layout::AttrSizeAbs:
+                break;
+            default:
+                clc::Log::error("ocher.render", "unknown OpPushTextAttr");
+                ASSERT(0);
+                break;
+        }
+    } else {
+        switch (op) {
+            case Layout::LineJustifyLeft:
+            case Layout::LineJustifyCenter:
+            case Layout::LineJustifyFull:
+            case Layout::LineJustifyRight:
+                a[ai].justify = op;
+                break;
+            default:
+                clc::Log::error("ocher.render", "unknown OpPushLineAttr");
+                ASSERT(0);
+                break;
+        }
+    }
+    return true;
+}
+
+void Renderer::getAttrStack(Pagination::AttrStack *attrs) const
+{
+    attrs->depth = ai - 1;
+    attrs->clamped = m_attrsClamped;
+    for (int i = 2; i <= ai; ++i)
+        attrs->ops[i-2] = m_attrOps[i];
+}
+
+void Renderer::setAttrStack(const Pagination::AttrStack &attrs)
+{
+    a[1] = Attrs();
+    ai = 1;
+    m_attrsClamped = 0;
+    for (unsigned int i = 0; i < attrs.depth; ++i)
+        pushAttr(attrs.ops[i]);
+    m_attrsClamped = attrs.clamped;
+}
+
 
 #if 0
 void Renderer::pushOp(uint16_t op)
@@ -17,4 +301,3 @@ void Renderer::pushTextAttr(TextAttr attr, uint8_t arg)
 }
 #endif
 
-
@@ -1,8 +1,14 @@
 #ifndef OCHER_UX_RENDERER_H
 #define OCHER_UX_RENDERER_H
 
+#include <stdint.h>
+#include <list>
+#include <vector>
+
 #include "clc/data/Buffer.h"
+#include "clc/os/Lock.h"
 
+#include "ocher/fmt/Format.h"
 #include "ocher/ux/Pagination.h"
 
 
@@ -10,7 +16,7 @@
  */
 class Attrs {
 public:
-    Attrs() : ul(0), b(0), em(0), pre(0), ws(0), nl(0), pts(12) {}
+    Attrs() : ul(0), b(0), em(0), pre(0), ws(0), nl(0), pts(12), justify(0) {}
     int ul;
     int b;
     int em;
@@ -18,6 +24,7 @@ public:
     int ws;
     int nl;
     int pts;   ///< text points
+    int justify;  ///< Layout::LineAttr
 };
 
 
@@ -31,20 +38,240 @@ public:
 
     virtual bool init() { return true; }
 
-    virtual void set(clc::Buffer layout) { m_layout = layout; }
+    virtual void set(clc::Buffer layout) { m_layout = layout; m_restarts.clear(); }
+
+    /**
+     * Fonts embedded in the document about to be set; renderers without fonts ignore them.
+     */
+    virtual void setFonts(const std::list<EmbeddedFont> &fonts) { (void)fonts; }
+
+    /**
+     * Changes the font size (initially settings.fontPoints), after which the book must be
+     * repaginated; so not while a Paginator is running.
+     * @return false if the renderer has no font sizes
+     */
+    virtual bool setFontPoints(int points) { (void)points; return false; }
 
     /**
-     * Render the page.
+     * Render the page.  Safe to call from several threads (for example, while a Paginator
+     * paginates); renders take turns.
      * @return -1 if this is an unknown page (prior page not paginated),
      *  0 if reached the end of the page and it overflowed;
      *  1 if reached the end of the layout (no overflow)
      */
     virtual int render(unsigned int pageNum, bool doBlit) = 0;
 
+    /**
+     * Draws the page starting at a position rather than a page number, for reading where
+     * pagination has not reached (see pageBefore).
+     * @param start  In, where the page starts, with the attributes open there.  Out, if the page
+     *      overflowed, where the next page starts.
+     * @return As render
+     */
+    virtual int renderAt(Pagination::Break *start) = 0;
+
+    /**
+     * Measures a page without drawing or paginating it, for estimating the number of pages.
+     * The page starts outside of any attributes.
+     * @param layoutOffset  In, where the page starts:  a CmdOutputStr outside of any attributes.
+     *      Out, the CmdOutputStr the page breaks in, or the CmdForcePage it breaks at.
+     * @param strOffset  In, where in the string the page starts.  Out, where the page breaks.
+     * @return As render
+     */
+    virtual int measure(unsigned int *layoutOffset, unsigned int *strOffset) = 0;
+
+    /**
+     * A renderer with the same geometry, fonts and layout but state of its own (for fb, its own
+     * FreeType, as faces are not thread-safe), so that chapters can be paginated on other
+     * threads.  Call from the thread that will use it.
+     * @return 0 if unsupported, in which case the book is paginated a page at a time.
+     */
+    virtual Renderer *clone() { return 0; }
+
+    /**
+     * Paginates one chapter, without publishing its pages.  Meant for clones.
+     * @param layoutOffset  Where the chapter starts:  0, or a CmdForcePage.
+     * @param end  Where the next chapter starts, or the size of the layout.
+     * @param breaks  Appended with the chapter's page breaks, ending with the break at end if
+     *      the book goes on.
+     * @return As render:  1 if the book ends with the chapter
+     */
+    virtual int paginateChapter(unsigned int layoutOffset, unsigned int end,
+            std::vector<Pagination::Break> &breaks) = 0;
+
+    /**
+     * Finds where the page before a position starts, by filling a page upward from it, for
+     * paging backward from a position that pagination has not reached (such as a contents
+     * entry or a search hit).  Costs a few pages of measuring, wherever the position is.  The
+     * page does not reach back into the previous chapter.
+     * @param start  In, where a page starts:  a page break, or a line start.  Out, where the
+     *      page before it starts, with the attributes open there.
+     * @return 0, or -1 if start is the start of the book
+     */
+    virtual int pageBefore(Pagination::Break *start) = 0;
+
+    /**
+     * Publishes page breaks found by paginateChapter, from pageNum on.
+     */
+    void setPageBreaks(unsigned int pageNum, const std::vector<Pagination::Break> &breaks);
+
+    /**
+     * Called by the Paginator as it publishes pages, so that pages which were not paginated yet
+     * can be rendered ahead now.
+     */
+    virtual void paginated() {}
+
+    /**
+     * @return Whether the string has nothing to show from strOffset on (only whitespace).  Such
+     *      text does not hold a page open at a forced page break.
+     */
+    static bool isBlank(const clc::Buffer *str, unsigned int strOffset);
+
+    /**
+     * Where the page ends, if paginated.  See Pagination::get.
+     */
+    bool pageBreak(unsigned int pageNum, unsigned int *layoutOffset, unsigned int *strOffset,
+            Pagination::AttrStack *attrs=0);
+
+    /**
+     * The page that the offsets fall on (for bookmarks, search hits, contents...), so far as
+     * paginated.  See Pagination::find.
+     */
+    unsigned int pageOf(unsigned int layoutOffset, unsigned int strOffset);
+
+    /**
+     * The layout bytecode.  Not replaced while a Paginator is running.
+     */
+    const clc::Buffer &layout() const { return m_layout; }
+
+    /**
+     * Appends everything besides the layout that decides where this renderer breaks pages:
+     * geometry, fonts, margins, ...  Keys the persisted pagination; see Pagination::save.
+     */
+    virtual void layoutKey(clc::Buffer &key) = 0;
+
+    /**
+     * Restores the pagination saved with the same key, after which every page is known.
+     * Otherwise the pagination is flushed, to be paginated afresh.
+     * @return The number of pages, or -1 if none was saved with this key.
+     */
+    int loadPagination(const char *path, const clc::Buffer &key);
+    void savePagination(const char *path, const clc::Buffer &key);
+
 protected:
+    /**
+     * Interprets the layout bytecode for one page.  This is the single copy of the opcode
+     * decoding shared by all renderers; the device-specific work is delegated to Policy (the
+     * derived renderer, which must befriend Renderer) through these members:
+     *  - template<bool doBlit> void beginPage();
+     *  - template<bool doBlit> void applyAttrs(int i);
+     *  - template<bool doBlit> int outputWrapped(clc::Buffer *b, const uint8_t *breaks,
+     *        unsigned int strOffset);  (breaks:  see LineBreak)
+     *  - template<bool doBlit> void endPage();
+     *
+     * doBlit is a compile-time constant, so the measure-only (pagination) instantiation contains
+     * no drawing.  Defined in ocher/ux/RenderLoop.h.
+     */
+    template<class Policy, bool doBlit> int renderPage(unsigned int pageNum);
+    /**
+     * Implements renderAt.
+     */
+    template<class Policy> int renderAtFrom(Pagination::Break *start);
+    /**
+     * Implements measure.
+     */
+    template<class Policy> int measureFrom(unsigned int *layoutOffset, unsigned int *strOffset);
+    /**
+     * Implements pageBefore.
+     */
+    template<class Policy> int pageBeforeFrom(Pagination::Break *start);
+    /**
+     * Appends the starts of the lines from from up to (not including) to.
+     */
+    template<class Policy> void lineStarts(const Pagination::Break &from,
+            const Pagination::Break &to, std::vector<Pagination::Break> &lines);
+    /**
+     * Implements paginateChapter.
+     */
+    template<class Policy> int paginateChapterFrom(unsigned int layoutOffset, unsigned int end,
+            std::vector<Pagination::Break> &breaks);
+    /**
+     * Renders one page from the offsets, which on overflow are set to where the page breaks.
+     */
+    template<class Policy, bool doBlit> int renderFrom(unsigned int *layoutOffset,
+            unsigned int *breakOffset);
+
+    /**
+     * If only blank text lies between the page break and the next CmdForcePage, moves the
+     * break to the CmdForcePage, so that a chapter's last page never spills a blank remainder
+     * into the next chapter's first page.
+     */
+    void skipToForcedBreak(unsigned int *layoutOffset, unsigned int *strOffset) const;
+
+    /**
+     * Indexes m_restarts.
+     */
+    void findRestarts();
+    /**
+     * @return Whether a is before b.  The end of a string is the same place as the start of
+     *      the next.
+     */
+    bool before(const Pagination::Break &a, const Pagination::Break &b) const;
+    void canonical(unsigned int *layoutOffset, unsigned int *strOffset) const;
+
+    /**
+     * Pushes a copy of the innermost attributes.  Past Pagination::AttrStack::maxDepth, counts
+     * the push instead, and popAttrs skips as many pops.
+     * @return false if counted rather than pushed
+     */
+    bool pushAttrs();
+    /**
+     * @return false if the pop was skipped
+     */
+    bool popAttrs();
+    /**
+     * Pushes the attribute set by the OpPushTextAttr or OpPushLineAttr bytecode.
+     * @return As pushAttrs; the attribute is ignored if not pushed.
+     */
+    bool pushAttr(uint16_t code);
+    /**
+     * Snapshots the attributes open, for a page break.
+     */
+    void getAttrStack(Pagination::AttrStack *attrs) const;
+    /**
+     * Reopens the attributes of a page break, replacing those open.
+     */
+    void setAttrStack(const Pagination::AttrStack &attrs);
+
+    clc::Lock m_renderLock;  ///< one render (and everything it uses) at a time; guards all below
     clc::Buffer m_layout;
     Pagination m_pagination;
+
+    /**
+     * A place where lines can be measured from without knowing what came before:  the start of
+     * a chapter, or of a paragraph.
+     */
+    struct Restart {
+        Pagination::Break at;
+        bool chapter;
+    };
+    static const unsigned int restartBytes = 4096;  ///< of text, at least, between restarts
+    std::vector<Restart> m_restarts;  ///< by offset; built by the first pageBefore
+    /**
+     * If not 0, pages end after this many lines (see pageBefore).  Renderers honor it when
+     * checking for overflow.
+     */
+    unsigned int m_lineLimit;
+
+    /**
+     * a[0] is unused and a[1] holds the defaults, so that the rest hold as many attributes as a
+     * Pagination::AttrStack.
+     */
+    static const int maxAttrs = Pagination::AttrStack::maxDepth + 2;
+    Attrs a[maxAttrs];
+    uint16_t m_attrOps[maxAttrs];  ///< the bytecode that pushed each of a
+    int ai;
+    unsigned int m_attrsClamped;  ///< pushes past the deepest attributes (see pushAttrs)
 };
 
 #endif
-
@@ -1,9 +1,13 @@
 #include <stdio.h>
 
+#include "clc/support/Logger.h"
+
 #include "ocher/device/Filesystem.h"
+#include "ocher/ux/Paginator.h"
 #include "ocher/ux/Renderer.h"
 #include "ocher/ux/fb/BrowseFb.h"
 #include "ocher/settings/Options.h"
+#include "ocher/settings/Settings.h"
 
 
 BrowseFb::BrowseFb()
@@ -23,14 +27,25 @@ void BrowseFb::browse()
 
 }
 
-void BrowseFb::read(Renderer& renderer)
+void BrowseFb::read(Renderer& renderer, Paginator& paginator)
 {
-    for (int pageNum = 0; ; ) {
-        if (renderer.render(pageNum, true) < 0)
+    for (Place place; ; ) {
+        if (show(place, renderer, paginator) < 0)
             break;
-
-        getchar(); //DDD
-        ++pageNum;
+        clc::Log::info("ocher", "%s", pageStatus(place, renderer, paginator).c_str());
+
+        int key = getchar(); //DDD
+        if (key == '+' || key == '-') {
+            getchar();  // its newline
+            const int points = settings.fontPoints + (key == '+' ? 1 : -1);
+            if (points > 0)
+                setFontPoints(points, place, renderer, paginator);
+        } else if (key == 'p' || key == 'b') {
+            getchar();  // its newline
+            back(place, renderer);
+        } else if (! forward(place, renderer)) {
+            break;
+        }
     }
 }
 
@@ -0,0 +1,56 @@
+#include <stdio.h>
+
+#include "clc/os/Stopwatch.h"
+
+#include "ocher/output/FreeType.h"
+#include "ocher/output/memory/FbMemory.h"
+#include "ocher/settings/Options.h"
+#include "ocher/ux/Paginator.h"
+#include "ocher/ux/Renderer.h"
+#include "ocher/ux/fb/BrowseFbMemory.h"
+
+
+BrowseFbMemory::BrowseFbMemory(FreeType *ft, FbMemory *fb) :
+    m_ft(ft),
+    m_fb(fb)
+{
+}
+
+void BrowseFbMemory::browse()
+{
+}
+
+void BrowseFbMemory::read(Renderer& renderer, Paginator& paginator)
+{
+    const unsigned long glyphs = m_ft->glyphsRendered();
+    uint64_t usec = 0;
+    unsigned int pages = 0;
+    for (;;) {
+        // Not timed:  pagination is not rendering.
+        if (! paginator.waitFor(pages))
+            break;
+        clc::Stopwatch sw;
+        int r = renderer.render(pages, true);
+        usec += sw.elapsedUSec();
+        if (r < 0)
+            break;
+
+        if (opt.dumpDir) {
+            char path[1024];
+            snprintf(path, sizeof(path), "%s/page%04u.%s", opt.dumpDir, pages, opt.dumpFormat);
+            if (! m_fb->save(path)) {
+                fprintf(stderr, "Cannot write %s; stopped at page %u\n", path, pages);
+                break;
+            }
+        }
+        ++pages;
+        if (r == 1)
+            break;
+    }
+
+    const unsigned long n = m_ft->glyphsRendered() - glyphs;
+    const double sec = usec ? usec / 1000000.0 : 1e-6;
+    printf("%u pages, %lu glyphs in %llu us:  %.1f pages/s, %.0f glyphs/s\n", pages, n,
+            (unsigned long long)usec, pages / sec, n / sec);
+}
+
@@ -0,0 +1,29 @@
+#ifndef OCHER_UX_FB_BROWSE_MEMORY_H
+#define OCHER_UX_FB_BROWSE_MEMORY_H
+
+#include "ocher/ux/Browse.h"
+
+class FbMemory;
+class FreeType;
+
+
+/**
+ * "Reads" by rendering every page in turn, optionally writing each out as an image, and
+ * reports how fast pages and glyphs were rendered.
+ */
+class BrowseFbMemory : public Browse
+{
+public:
+    BrowseFbMemory(FreeType *ft, FbMemory *fb);
+    ~BrowseFbMemory() {}
+
+    void browse();
+    void read(Renderer& renderer, Paginator& paginator);
+
+protected:
+    FreeType *m_ft;
+    FbMemory *m_fb;
+};
+
+#endif
+
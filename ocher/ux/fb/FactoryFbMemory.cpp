@@ -0,0 +1,43 @@
+#include <string.h>
+
+#include "ocher/ocher.h"
+#include "ocher/settings/Options.h"
+#include "ocher/ux/fb/FactoryFbMemory.h"
+
+
+UX_DRIVER_REGISTER(FbMemory);
+
+
+UiFactoryFbMemory::UiFactoryFbMemory() :
+    UiFactoryFb(&m_fb),
+    m_fb(600, 800, 167),
+    m_bench(&m_ft, &m_fb)
+{
+}
+
+UiFactoryFbMemory::~UiFactoryFbMemory()
+{
+}
+
+bool UiFactoryFbMemory::init()
+{
+    // It always works, so it would otherwise hide the lack of a real display.
+    if (! opt.driverName || strcmp(opt.driverName, getName()) != 0)
+        return false;
+
+    m_fb.resize(opt.width, opt.height, opt.dpi);
+    // Benchmarks must be repeatable, so render each page when it is shown.
+    m_render.setRenderAhead(false);
+    return m_render.init();
+}
+
+const char* UiFactoryFbMemory::getName()
+{
+    return "memory";
+}
+
+Browse& UiFactoryFbMemory::getBrowser()
+{
+    return m_bench;
+}
+
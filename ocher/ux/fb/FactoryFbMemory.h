@@ -0,0 +1,29 @@
+#ifndef OCHER_UX_FACTORY_FB_MEMORY_H
+#define OCHER_UX_FACTORY_FB_MEMORY_H
+
+#include "ocher/ux/fb/BrowseFbMemory.h"
+#include "ocher/ux/fb/FactoryFb.h"
+#include "ocher/output/memory/FbMemory.h"
+
+
+/**
+ * Renders into memory, headless:  for benchmarks and golden images on machines without a
+ * display.  Only used when asked for by name.
+ */
+class UiFactoryFbMemory : public UiFactoryFb
+{
+public:
+    UiFactoryFbMemory();
+    ~UiFactoryFbMemory();
+
+    bool init();
+    const char* getName();
+    Browse& getBrowser();
+
+protected:
+    FbMemory m_fb;
+    BrowseFbMemory m_bench;
+};
+
+#endif
+
@@ -0,0 +1,11 @@
+#include "ocher/ux/fb/LineCache.h"
+
+
+const WrappedText *LineCache::put(const Key &key, WrappedText *w)
+{
+    // Wrappings are cheap to recompute; bound the memory rather than track use.
+    if (m_lines.size() >= maxEntries)
+        m_lines.clear();
+    m_lines.put(&key, sizeof(key), w);
+    return w;
+}
@@ -0,0 +1,91 @@
+#ifndef OCHER_UX_FB_LINECACHE_H
+#define OCHER_UX_FB_LINECACHE_H
+
+#include <stdint.h>
+#include <vector>
+
+#include "clc/data/Buffer.h"
+#include "clc/data/Hashtable.h"
+
+
+/**
+ * One line's worth of a wrapped string:  a run of consecutive glyphs drawn from a pen position,
+ * and what happens at the end of the line.
+ */
+struct LineBox
+{
+    uint32_t glyph;  ///< first glyph, as an index into the string's ShapedRuns run
+    uint32_t byte;   ///< byte offset of the first glyph in the string
+    uint16_t count;  ///< glyphs drawn; may be 0 (an empty line)
+    int16_t x;       ///< pen x of the first glyph
+    int16_t width;   ///< sum of the advances
+    uint8_t hard;    ///< the line ends at a newline rather than wrapping
+    /**
+     * If >= 0, the line ends by advancing the pen a line, after which the text resumes at this
+     * byte offset (where the next page starts, if the advance crosses the bottom margin).
+     */
+    int32_t resume;
+};
+
+/**
+ * How a string (from some offset) wraps into lines, independent of where the lines fall
+ * vertically.
+ */
+struct WrappedText
+{
+    WrappedText() : penX(0), col(0), advanced(false) {}
+
+    std::vector<LineBox> boxes;
+    int penX;       ///< pen x after the string
+    int col;        ///< glyphs added to the last line
+    bool advanced;  ///< whether any box advances a line (so the last line is a new one)
+};
+
+/**
+ * Remembers how strings wrapped, so that pagination and drawing wrap each string once.  Line
+ * breaking depends on the string and offset, the font configuration (face and size, from
+ * FreeType::config), the pen position where the string starts, and the left and right margins;
+ * all are in the key.  Vertical position is not, so a wrapping is reused wherever on the page it
+ * falls.
+ */
+class LineCache
+{
+public:
+    struct Key {
+        const clc::Buffer *str;
+        unsigned int strOffset;
+        unsigned int config;
+        int penX;
+        int lineStarted;
+        int left;
+        int right;
+    };
+
+    /**
+     * @return The wrapping, or 0 if not cached.
+     */
+    const WrappedText *get(const Key &key) const { return (WrappedText*)m_lines.get(&key, sizeof(key)); }
+
+    /**
+     * Takes ownership of w.
+     */
+    const WrappedText *put(const Key &key, WrappedText *w);
+
+    void clear() { m_lines.clear(); }
+
+protected:
+    static const unsigned int maxEntries = 4096;
+
+    class LineTable : public clc::Hashtable
+    {
+    public:
+        LineTable() : clc::Hashtable(1024) {}
+        ~LineTable() { clear(); }
+    protected:
+        void deleteValue(void *value) const { delete (WrappedText*)value; }
+    };
+
+    LineTable m_lines;
+};
+
+#endif
@@ -0,0 +1,162 @@
+#include <stdlib.h>
+
+#include "clc/support/Logger.h"
+
+#include "ocher/output/memory/FbMemory.h"
+#include "ocher/ux/fb/PageRing.h"
+#include "ocher/ux/fb/RenderFb.h"
+
+
+PageRing::PageRing(RenderFb *render) :
+    clc::Thread("page ring"),
+    m_render(render),
+    m_current(-1),
+    m_busy(-1),
+    m_failed(-1),
+    m_generation(0),
+    m_stop(false)
+{
+}
+
+PageRing::~PageRing()
+{
+    stop();
+    for (unsigned int i = 0; i < slots; ++i)
+        delete m_slots[i].fb;
+}
+
+void PageRing::stop()
+{
+    m_monitor.lock();
+    m_stop = true;
+    m_monitor.notifyAll();
+    m_monitor.unlock();
+    join();
+}
+
+bool PageRing::holds(int pageNum) const
+{
+    for (unsigned int i = 0; i < slots; ++i) {
+        if (m_slots[i].page == pageNum)
+            return true;
+    }
+    return false;
+}
+
+int PageRing::want() const
+{
+    if (m_current < 0)
+        return -1;
+    const int candidates[2] = { m_current + 1, m_current - 1 };
+    for (unsigned int i = 0; i < 2; ++i) {
+        int page = candidates[i];
+        if (page >= 0 && page != m_busy && page != m_failed && ! holds(page))
+            return page;
+    }
+    return -1;
+}
+
+int PageRing::show(unsigned int pageNum, FrameBuffer *screen)
+{
+    int r = miss;
+    m_monitor.lock();
+    // Rather than render it twice, wait for the worker to finish it.
+    while (m_busy == (int)pageNum)
+        m_monitor.wait();
+    for (unsigned int i = 0; i < slots; ++i) {
+        Slot &slot = m_slots[i];
+        if (slot.page == (int)pageNum) {
+            screen->blitPacked(slot.fb->pixels(), 0, 0, slot.fb->width(), slot.fb->height());
+            screen->update(0, 0, slot.fb->width(), slot.fb->height(), false);
+            r = slot.result;
+            break;
+        }
+    }
+    m_monitor.unlock();
+    return r;
+}
+
+void PageRing::request(unsigned int pageNum, FrameBuffer *screen)
+{
+#ifndef SINGLE_THREADED
+    m_monitor.lock();
+    if (! m_slots[0].fb) {
+        for (unsigned int i = 0; i < slots; ++i)
+            m_slots[i].fb = new FbMemory(screen->width(), screen->height(), screen->dpi(),
+                    screen->bpp());
+        try {
+            start();
+        } catch (...) {
+            clc::Log::warn("ocher.render", "no page ring worker; pages render on demand");
+        }
+    }
+    if (m_current != (int)pageNum) {
+        m_current = pageNum;
+        m_failed = -1;
+    }
+    m_monitor.notifyAll();
+    m_monitor.unlock();
+#else
+    (void)pageNum;
+    (void)screen;
+#endif
+}
+
+void PageRing::invalidate()
+{
+    m_monitor.lock();
+    ++m_generation;
+    for (unsigned int i = 0; i < slots; ++i)
+        m_slots[i].page = -1;
+    m_failed = -1;
+    m_monitor.notifyAll();
+    m_monitor.unlock();
+}
+
+void PageRing::paginated()
+{
+    m_monitor.lock();
+    if (m_failed >= 0) {
+        m_failed = -1;
+        m_monitor.notifyAll();
+    }
+    m_monitor.unlock();
+}
+
+void PageRing::run()
+{
+    m_monitor.lock();
+    for (;;) {
+        int page = -1;
+        while (! m_stop && (page = want()) < 0)
+            m_monitor.wait();
+        if (m_stop)
+            break;
+
+        // Reuse the slot farthest from the current page.
+        Slot *slot = &m_slots[0];
+        for (unsigned int i = 0; i < slots && slot->page != -1; ++i) {
+            Slot *s = &m_slots[i];
+            if (s->page == -1 || abs(s->page - m_current) > abs(slot->page - m_current))
+                slot = s;
+        }
+        slot->page = -1;
+        m_busy = page;
+        const unsigned int generation = m_generation;
+        m_monitor.unlock();
+
+        int r = m_render->renderTo(slot->fb, page);
+
+        m_monitor.lock();
+        m_busy = -1;
+        if (r < 0) {
+            m_failed = page;
+        } else if (generation == m_generation) {
+            slot->page = page;
+            slot->result = r;
+            clc::Log::debug("ocher.render", "page %d rendered ahead", page);
+        }
+        m_monitor.notifyAll();
+    }
+    m_monitor.unlock();
+}
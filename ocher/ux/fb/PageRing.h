@@ -0,0 +1,77 @@
+#ifndef OCHER_UX_FB_PAGERING_H
+#define OCHER_UX_FB_PAGERING_H
+
+#include "clc/os/Monitor.h"
+#include "clc/os/Thread.h"
+
+class FbMemory;
+class FrameBuffer;
+class RenderFb;
+
+
+/**
+ * A small ring of pages rendered ahead, off-screen, by a worker thread.  Once a page is shown,
+ * the worker renders the next and then the previous page, so that turning to either is a copy
+ * to the screen rather than a render.
+ */
+class PageRing : public clc::Thread
+{
+public:
+    PageRing(RenderFb *render);
+    ~PageRing();
+
+    static const int miss = -2;
+
+    /**
+     * If the page is in the ring (or is being rendered into it), draws it to the screen.
+     * @return As Renderer::render, or miss.
+     */
+    int show(unsigned int pageNum, FrameBuffer *screen);
+
+    /**
+     * Notes that the page is being shown, so that its neighbours are rendered next.
+     */
+    void request(unsigned int pageNum, FrameBuffer *screen);
+
+    /**
+     * Drops every page, for example because the layout or settings changed.  A page being
+     * rendered meanwhile is discarded when it completes.
+     */
+    void invalidate();
+
+    /**
+     * Notes that more pages are paginated, so that a page the worker could not render is
+     * retried.
+     */
+    void paginated();
+
+    void stop();
+
+protected:
+    void run();
+
+    /**
+     * @return The page the worker should render next, or -1.
+     */
+    int want() const;
+    bool holds(int pageNum) const;
+
+    struct Slot {
+        Slot() : fb(0), page(-1), result(0) {}
+        FbMemory *fb;
+        int page;    ///< -1 if empty
+        int result;  ///< what rendering the page returned
+    };
+    static const unsigned int slots = 3;
+
+    RenderFb *m_render;
+    clc::Monitor m_monitor;  ///< guards all below
+    Slot m_slots[slots];
+    int m_current;  ///< page last shown, or -1
+    int m_busy;     ///< page the worker is rendering, or -1
+    int m_failed;   ///< page the worker could not render (not yet paginated), or -1
+    unsigned int m_generation;
+    bool m_stop;
+};
+
+#endif
@@ -1,4 +1,5 @@
 #include <ctype.h>
+#include <string.h>
 
 #include "clc/support/Debug.h"
 #include "clc/support/Logger.h"
@@ -7,43 +8,94 @@
 #include "ocher/output/FreeType.h"
 #include "ocher/output/FrameBuffer.h"
 #include "ocher/settings/Settings.h"
+#include "ocher/ux/RenderLoop.h"
 #include "ocher/ux/fb/RenderFb.h"
 
 
 RenderFb::RenderFb(FreeType *ft, FrameBuffer *fb) :
     m_ft(ft),
+    m_ownFt(0),
+    m_screen(fb),
     m_fb(fb),
+    m_runs(ft),
+    m_lineGeneration(0),
     m_col(0),
     m_penX(settings.marginLeft),
     m_penY(settings.marginTop),
     m_lineHeight(10),
     m_page(1),
-    ai(1)
+    m_renderAhead(true),
+    m_ring(this)
 {
 }
 
+RenderFb::~RenderFb()
+{
+    delete m_ownFt;
+}
+
 bool RenderFb::init()
 {
+    clc::Locker locker(m_renderLock);
     if (! m_ft->init())
         return false;
     m_ft->setSize(settings.fontPoints);
+    m_ring.invalidate();
+    return true;
+}
+
+void RenderFb::set(clc::Buffer layout)
+{
+    {
+        clc::Locker locker(m_renderLock);
+        Renderer::set(layout);
+        // Runs and lines are keyed by string; a new layout may reuse the addresses.
+        m_runs.clear();
+        m_lines.clear();
+    }
+    m_ring.invalidate();
+}
+
+void RenderFb::setFonts(const std::list<EmbeddedFont> &fonts)
+{
+    {
+        clc::Locker locker(m_renderLock);
+        if (! m_ft->setBookFonts(fonts)) {
+            clc::Log::warn("ocher.render", "book fonts unusable; keeping the current fonts");
+            return;
+        }
+    }
+    m_ring.invalidate();
+}
+
+bool RenderFb::setFontPoints(int points)
+{
+    {
+        clc::Locker locker(m_renderLock);
+        m_ft->setSize(points);
+    }
+    m_ring.invalidate();
     return true;
 }
 
-void RenderFb::pushAttrs()
+void RenderFb::layoutKey(clc::Buffer &key)
 {
-    a[ai+1] = a[ai];
-    ai++;
+    key.appendFormat("fb %ux%u %udpi\n", m_screen->width(), m_screen->height(), m_screen->dpi());
+    key.appendFormat("margins %d %d %d %d\n", settings.marginTop, settings.marginRight,
+            settings.marginBottom, settings.marginLeft);
+    key.appendFormat("points %u\n", m_ft->points());
+    m_ft->fontKey(key);
 }
 
-void RenderFb::popAttrs()
+template<bool doBlit>
+void RenderFb::applyAttrs(int)
 {
-    ai--;
+    m_ft->setStyle(a[ai].b, a[ai].em);
 }
 
-int RenderFb::outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doBlit)
+WrappedText *RenderFb::wrap(clc::Buffer *b, const uint8_t *breaks, unsigned int strOffset)
 {
-    int dx, dy;
+    WrappedText *w = new WrappedText;
     int len = b->size();
     const unsigned char *start = (const unsigned char*)b->data();
     const unsigned char *p = start;
@@ -52,213 +104,362 @@ int RenderFb::outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doBlit)
     len -= strOffset;
     p += strOffset;
 
-    // TODO:  first time on a page, must penY+= bearingY of current face
-    // TODO:  proper word wrap
-    // TODO:  paginate
+    // The run has one entry per codepoint; g tracks p.
+    const ShapedGlyph *run = m_runs.get(b);
+    const ShapedGlyph *g = run + ShapedRuns::glyphOffset(b, strOffset);
+
+    // Wrap as if the page were endless, noting each line advance and where the text resumes
+    // after it; whoever draws the lines decides which advance crosses the bottom margin.
+    LineBox box;
+    box.glyph = g - run;
+    box.byte = p - start;
+    box.count = 0;
+    box.x = m_penX;
+    box.width = 0;
+    int penX = m_penX;
+    int col = m_col ? 1 : 0;  // only whether the line has started matters to wrapping
+    w->col = 0;
 
     bool wordWrapped = false;
     int width = m_fb->width();
+    const int right = width-1 - settings.marginRight;
     do {
         // If at start of line, eat spaces
-        if (m_col == 0) {
+        if (col == 0) {
             while (*p != '\n' && isspace(*p)) {
                 ++p;
                 --len;
+                ++g;
             }
         }
 
         if (*p != '\n') {
-            // Where is the next word break?
-            const unsigned char *end = p;
-            while (*end && !isspace(*end)) {
-                ++end;
-            }
-            if (*end)
-                ++end;
+            // Where is the next break opportunity?
+            const unsigned char *end = start + LineBreak::next(breaks, p - start, b->size());
 
-            // Output until EOL (\n or wrap)
-            for ( ; p < end && *p != '\n'; ++p, --len) {
-                uint32_t c = *p;
-                if (c > 0x7f) {
-                    // Convert UTF8 to UTF32, as required by FreeType
-                    if ((c & 0xe0) == 0xc0) {
-                        c = ((c & 0x1f) << 6) | (p[1] & 0x3f);
-                        p += 1;
-                        len -= 1;
-                    } else if ((c & 0xf0) == 0xe0) {
-                        c = ((c & 0x0f) << 12) | ((p[1] & 0x3f) << 6) | (p[2] & 0x3f);
-                        p += 2;
-                        len -= 2;
-                    } else if ((c & 0xf8) == 0xf0) {
-                        c = ((c & 0x07) << 18) | ((p[1] & 0x3f) << 12) | ((p[2] & 0x3f) << 6) | (p[3] & 0x3f);
-                        p += 3;
-                        len -= 3;
-                    } else if ((c & 0xfc) == 0xf8) {
-                        c = ((c & 0x03) << 24) | ((p[1] & 0x3f) << 18) | ((p[2] & 0x3f) << 12) | ((p[3] & 0x3f) << 6) | (p[4] & 0x3f);
-                        p += 4;
-                        len -= 4;
-                    } else if ((c & 0xfe) == 0xfc) {
-                        c = ((c & 0x01) << 30) | ((p[1] & 0x3f) << 24) | ((p[2] & 0x3f) << 18) | ((p[3] & 0x3f) << 12) | ((p[4] & 0x3f) << 6) | (p[5] & 0x3f);
-                        p += 5;
-                        len -= 5;
-                    } else {
-                        // out of sync?
+            // Wrap before the segment if it won't fit; trailing spaces may hang.
+            if (col != 0 && (p != start || LineBreak::isBreak(breaks, 0))) {
+                int segWidth = 0;
+                int inkWidth = 0;
+                const ShapedGlyph *sg = g;
+                for (const unsigned char *q = p; q < end && *q != '\n'; ) {
+                    unsigned int n = ShapedRuns::utf8Len(q, end - q);
+                    if (! n) {
+                        ++q;
                         continue;
                     }
+                    segWidth += sg->advance;
+                    if (*q != ' ')
+                        inkWidth = segWidth;
+                    ++sg;
+                    q += n;
+                }
+                if (penX + inkWidth >= right) {
+                    col = 0;
+                    penX = settings.marginLeft;
+                    wordWrapped = true;
+                    box.hard = 0;
+                    box.resume = p - start;
+                    w->boxes.push_back(box);
+                    box.count = 0;
+                    box.x = penX;
+                    box.width = 0;
+                    w->advanced = true;
+                    w->col = 0;
                 }
+            }
 
-                // TODO:  probably have to move the freetype stuff inline here
-                // for proper wordwrap
-                if (m_ft->renderGlyph(c, doBlit, m_penX, m_penY, &dx, &dy, &m_lineHeight)) {
-                    m_penX += dx;
-                    m_penY += dy;
+            // Output until EOL (\n or wrap)
+            for ( ; p < end && *p != '\n'; ++p, --len) {
+                unsigned int n = ShapedRuns::utf8Len(p, len);
+                if (! n) {
+                    // out of sync?
+                    continue;
                 }
-                if (m_penX >= width-1 - settings.marginRight) {
+                if (! box.count) {
+                    box.glyph = g - run;
+                    box.byte = p - start;
+                    box.x = penX;
+                }
+                p += n-1;
+                len -= n-1;
+
+                ++box.count;
+                box.width += g->advance;
+                penX += g->advance;
+                ++g;
+                wordWrapped = false;
+                if (penX >= right) {
                     ++p;
                     --len;
                     break;
                 }
-                m_col ++;
+                col ++;
+                w->col ++;
             }
         }
 
         // Word-wrap or hard linefeed, but avoid the two back-to-back.
-        if ((*p == '\n' && !wordWrapped) || m_penX >= width-1 - settings.marginRight) {
-            m_col = 0;
-            m_penX = settings.marginLeft;
-            m_penY += m_lineHeight;
+        if (*p == '\n' && wordWrapped) {
+            ++p;
+            --len;
+            ++g;
+            wordWrapped = false;
+        } else if (*p == '\n' || penX >= right) {
+            col = 0;
+            penX = settings.marginLeft;
+            box.hard = *p == '\n';
             if (*p == '\n') {
                 p++;
                 len--;
+                ++g;
             } else {
                 wordWrapped = true;
             }
-            if (m_penY > (int)m_fb->height() - settings.marginBottom) {
-                return p - start;
-            }
+            box.resume = p - start;
+            w->boxes.push_back(box);
+            box.count = 0;
+            box.x = penX;
+            box.width = 0;
+            w->advanced = true;
+            w->col = 0;
         }
     } while (len > 0);
+
+    if (box.count) {
+        box.hard = 0;
+        box.resume = -1;
+        w->boxes.push_back(box);
+    }
+    w->penX = penX;
+    return w;
+}
+
+template<bool doBlit>
+int RenderFb::outputWrapped(clc::Buffer *b, const uint8_t *breaks, unsigned int strOffset)
+{
+    if (m_lineGeneration != m_ft->generation()) {
+        m_lines.clear();
+        m_lineGeneration = m_ft->generation();
+    }
+    LineCache::Key key;
+    memset(&key, 0, sizeof(key));
+    key.str = b;
+    key.strOffset = strOffset;
+    key.config = m_ft->config();
+    key.penX = m_penX;
+    key.lineStarted = m_col != 0;
+    key.left = settings.marginLeft;
+    key.right = m_fb->width()-1 - settings.marginRight;
+    const WrappedText *w = m_lines.get(key);
+    if (! w)
+        w = m_lines.put(key, wrap(b, breaks, strOffset));
+
+    // Lines are drawn once complete (they may continue in the next string), when their extent
+    // is known and they can be justified.
+    const ShapedGlyph *run = doBlit ? m_runs.get(b) : 0;
+    const int bottom = (int)m_fb->height() - settings.marginBottom;
+    for (unsigned int i = 0; i < w->boxes.size(); ++i) {
+        const LineBox &box = w->boxes[i];
+        if (doBlit && box.count) {
+            m_pending.push_back(PendingRun());
+            PendingRun &pr = m_pending.back();
+            pr.str = b;
+            pr.run = run;
+            pr.box = box;
+            pr.bold = a[ai].b;
+            pr.em = a[ai].em;
+            pr.justify = a[ai].justify;
+        }
+        if (box.resume >= 0) {
+            if (doBlit)
+                flushLine(box.hard);
+            m_penY += m_lineHeight;
+            if (m_penY > bottom ||
+                    (m_lineLimit && m_penY >= settings.marginTop + (int)m_lineLimit*m_lineHeight)) {
+                m_col = 0;
+                m_penX = settings.marginLeft;
+                return box.resume;
+            }
+        }
+    }
+    m_penX = w->penX;
+    m_col = (w->advanced ? 0 : m_col) + w->col;
     return -1;  // think of this as "failed to cross page boundary"
 }
 
-int RenderFb::render(unsigned int pageNum, bool doBlit)
+void RenderFb::flushLine(bool lastOfParagraph)
+{
+    if (m_pending.empty())
+        return;
+    const int right = m_fb->width()-1 - settings.marginRight;
+    const int justify = m_pending[0].justify;
+
+    // Where the ink ends (trailing spaces hang), and how many spaces precede it.
+    int shift = 0;
+    int extra = 0;
+    unsigned int spaces = 0;
+    if (justify != Layout::LineJustifyLeft) {
+        int inkEnd = m_pending[0].box.x;
+        unsigned int pendingSpaces = 0;
+        for (unsigned int i = 0; i < m_pending.size(); ++i) {
+            const PendingRun &pr = m_pending[i];
+            const unsigned char *p = (const unsigned char*)pr.str->data() + pr.box.byte;
+            const unsigned char *end = (const unsigned char*)pr.str->data() + pr.str->size();
+            const ShapedGlyph *g = pr.run + pr.box.glyph;
+            int x = pr.box.x;
+            for (unsigned int k = 0; k < pr.box.count; ++k, ++g) {
+                unsigned int n;
+                while (! (n = ShapedRuns::utf8Len(p, end - p)))
+                    ++p;
+                x += g->advance;
+                if (*p == ' ') {
+                    ++pendingSpaces;
+                } else {
+                    inkEnd = x;
+                    spaces += pendingSpaces;
+                    pendingSpaces = 0;
+                }
+                p += n;
+            }
+        }
+        if (justify == Layout::LineJustifyCenter)
+            shift = (right - inkEnd) / 2;
+        else if (justify == Layout::LineJustifyRight)
+            shift = right - inkEnd;
+        else if (justify == Layout::LineJustifyFull && ! lastOfParagraph && spaces)
+            extra = right - inkEnd;
+        if (shift < 0)
+            shift = 0;
+        if (extra < 0)
+            extra = 0;
+    }
+
+    // Draw, spreading any extra space over the spaces between words.
+    unsigned int space = 0;
+    int stretch = 0;
+    for (unsigned int i = 0; i < m_pending.size(); ++i) {
+        const PendingRun &pr = m_pending[i];
+        m_ft->setStyle(pr.bold, pr.em);
+        const unsigned char *p = (const unsigned char*)pr.str->data() + pr.box.byte;
+        const unsigned char *end = (const unsigned char*)pr.str->data() + pr.str->size();
+        const ShapedGlyph *g = pr.run + pr.box.glyph;
+        int x = pr.box.x + shift + stretch;
+        for (unsigned int k = 0; k < pr.box.count; ++k, ++g) {
+            m_ft->renderGlyph(g->glyph, x, m_penY);
+            x += g->advance;
+            if (extra) {
+                unsigned int n;
+                while (! (n = ShapedRuns::utf8Len(p, end - p)))
+                    ++p;
+                if (*p == ' ' && space < spaces) {
+                    ++space;
+                    int s = extra * space / spaces;
+                    x += s - stretch;
+                    stretch = s;
+                }
+                p += n;
+            }
+        }
+    }
+    m_ft->setStyle(a[ai].b, a[ai].em);
+    m_pending.clear();
+}
+
+template<bool doBlit>
+void RenderFb::beginPage()
 {
+    m_col = 0;
     m_penX = settings.marginLeft;
     m_penY = settings.marginTop;
-    m_fb->clear();
-
-    unsigned int layoutOffset;
-    unsigned int strOffset;
-    if (!pageNum) {
-        layoutOffset = 0;
-        strOffset = 0;
-    } else if (! m_pagination.get(pageNum-1, &layoutOffset, &strOffset)) {
-        // Previous page not already paginated?
-        // Perhaps at end of book?
-        return -1;
+    m_ft->setStyle(a[ai].b, a[ai].em);
+    m_lineHeight = m_ft->lineHeight();
+    m_pending.clear();
+    m_runs.trim();
+    if (doBlit)
+        m_fb->clear();
+}
+
+template<bool doBlit>
+void RenderFb::endPage()
+{
+    if (doBlit)
+        flushLine(true);
+    if (doBlit)
+        m_fb->update(0, 0, m_fb->width(), m_fb->height(), false); // DDD
+}
+
+int RenderFb::render(unsigned int pageNum, bool doBlit)
+{
+    if (! doBlit) {
+        clc::Locker locker(m_renderLock);
+        return renderPage<RenderFb, false>(pageNum);
     }
 
-    const unsigned int N = m_layout.size();
-    const char *raw = m_layout.data();
-    ASSERT(layoutOffset < N);
-    for (unsigned int i = layoutOffset; i < N; ) {
-        ASSERT(i+2 <= N);
-        uint16_t code = *(uint16_t*)(raw+i);
-        i += 2;
-
-        unsigned int opType = (code>>12)&0xf;
-        unsigned int op = (code>>8)&0xf;
-        unsigned int arg = code & 0xff;
-        switch (opType) {
-            case Layout::OpPushTextAttr:
-                clc::Log::debug("ocher.render.fb", "OpPushTextAttr");
-                switch (op) {
-                    case Layout::AttrBold:
-                        pushAttrs();
-                        a[ai].b = 1;
-                        break;
-                    case Layout::AttrUnderline:
-                        pushAttrs();
-                        a[ai].ul = 1;
-                        break;
-                    case Layout::AttrItalics:
-                        pushAttrs();
-                        a[ai].em = 1;
-                        break;
-                    case Layout::AttrSizeRel:
-                        pushAttrs();
-                        break;
-                    case Layout::AttrSizeAbs:
-                        pushAttrs();
-                        break;
-                    default:
-                        clc::Log::error("ocher.render.fb", "unknown OpPushTextAttr");
-                        ASSERT(0);
-                        break;
-                }
-                break;
-            case Layout::OpPushLineAttr:
-                clc::Log::debug("ocher.render.fb", "OpPushLineAttr");
-                switch (op) {
-                    case Layout::LineJustifyLeft:
-                        break;
-                    case Layout::LineJustifyCenter:
-                        break;
-                    case Layout::LineJustifyFull:
-                        break;
-                    case Layout::LineJustifyRight:
-                        break;
-                    default:
-                        clc::Log::error("ocher.render.fb", "unknown OpPushLineAttr");
-                        ASSERT(0);
-                        break;
-                }
-                break;
-            case Layout::OpCmd:
-                switch (op) {
-                    case Layout::CmdPopAttr:
-                        clc::Log::debug("ocher.render.fb", "OpCmd CmdPopAttr");
-                        if (arg == 0)
-                            arg = 1;
-                        while (arg--)
-                            popAttrs();
-                        break;
-                    case Layout::CmdOutputStr: {
-                        clc::Log::debug("ocher.render.fb", "OpCmd CmdOutputStr");
-                        ASSERT(i + sizeof(clc::Buffer*) <= N);
-                        clc::Buffer *str = *(clc::Buffer**)(raw+i);
-                        ASSERT(strOffset <= str->size());
-                        int breakOffset = outputWrapped(str, strOffset, doBlit);
-                        strOffset = 0;
-                        if (breakOffset >= 0) {
-                            if (!doBlit) {
-                                m_pagination.set(pageNum, i-2, breakOffset);
-                            }
-                            m_fb->update(0, 0, m_fb->width(), m_fb->height(), false); // DDD
-                            return 0;
-                        }
-                        i += sizeof(clc::Buffer*);
-                        break;
-                    }
-                    case Layout::CmdForcePage:
-                        clc::Log::debug("ocher.render.fb", "OpCmd CmdForcePage");
-                        break;
-                    default:
-                        clc::Log::error("ocher.render.fb", "unknown OpCmd");
-                        ASSERT(0);
-                        break;
-                }
-                break;
-            case Layout::OpSpacing:
-                break;
-            case Layout::OpImage:
-                break;
-            default:
-                clc::Log::error("ocher.render.fb", "unknown op type");
-                ASSERT(0);
-                break;
-        };
+    int r = m_ring.show(pageNum, m_screen);
+    if (r == PageRing::miss) {
+        clc::Locker locker(m_renderLock);
+        r = renderPage<RenderFb, true>(pageNum);
+    }
+    if (r >= 0 && m_renderAhead)
+        m_ring.request(pageNum, m_screen);
+    return r;
+}
+
+int RenderFb::renderAt(Pagination::Break *start)
+{
+    clc::Locker locker(m_renderLock);
+    return renderAtFrom<RenderFb>(start);
+}
+
+int RenderFb::measure(unsigned int *layoutOffset, unsigned int *strOffset)
+{
+    clc::Locker locker(m_renderLock);
+    return measureFrom<RenderFb>(layoutOffset, strOffset);
+}
+
+Renderer *RenderFb::clone()
+{
+    // Only measures, so shares the screen for its geometry.
+    FreeType *ft = new FreeType(m_screen);
+    RenderFb *r = new RenderFb(ft, m_screen);
+    r->m_ownFt = ft;
+    r->m_renderAhead = false;
+    unsigned int points;
+    {
+        clc::Locker locker(m_renderLock);
+        ft->setBookFonts(m_ft->bookFonts());
+        r->m_layout = m_layout;
+        points = m_ft->points();
+    }
+    if (! r->init()) {
+        delete r;
+        return 0;
     }
-    m_fb->update(0, 0, m_fb->width(), m_fb->height(), false); // DDD
-    return 1;
+    ft->setSize(points);
+    return r;
+}
+
+int RenderFb::paginateChapter(unsigned int layoutOffset, unsigned int end,
+        std::vector<Pagination::Break> &breaks)
+{
+    clc::Locker locker(m_renderLock);
+    return paginateChapterFrom<RenderFb>(layoutOffset, end, breaks);
+}
+
+int RenderFb::pageBefore(Pagination::Break *start)
+{
+    clc::Locker locker(m_renderLock);
+    return pageBeforeFrom<RenderFb>(start);
+}
+
+int RenderFb::renderTo(FrameBuffer *fb, unsigned int pageNum)
+{
+    clc::Locker locker(m_renderLock);
+    m_fb = fb;
+    m_ft->setFrameBuffer(fb);
+    int r = renderPage<RenderFb, true>(pageNum);
+    m_fb = m_screen;
+    m_ft->setFrameBuffer(m_screen);
+    return r;
 }
@@ -1,7 +1,12 @@
 #ifndef OCHER_FB_RENDER_H
 #define OCHER_FB_RENDER_H
 
+#include <vector>
+
+#include "ocher/output/ShapedRuns.h"
 #include "ocher/ux/Renderer.h"
+#include "ocher/ux/fb/LineCache.h"
+#include "ocher/ux/fb/PageRing.h"
 
 class FreeType;
 class FrameBuffer;
@@ -11,26 +16,86 @@ class RenderFb : public Renderer
 {
 public:
     RenderFb(FreeType *ft, FrameBuffer *fb);
+    ~RenderFb();
 
     bool init();
-    int outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doBlit);
+    void set(clc::Buffer layout);
+    void setFonts(const std::list<EmbeddedFont> &fonts);
+    bool setFontPoints(int points);
     int render(unsigned int pageNum, bool doBlit);
+    int renderAt(Pagination::Break *start);
+    int measure(unsigned int *layoutOffset, unsigned int *strOffset);
+    Renderer *clone();
+    int paginateChapter(unsigned int layoutOffset, unsigned int end,
+            std::vector<Pagination::Break> &breaks);
+    int pageBefore(Pagination::Break *start);
+    void layoutKey(clc::Buffer &key);
+
+    /**
+     * Drops pages rendered ahead; call after changing anything that affects rendering.
+     */
+    void invalidate() { m_ring.invalidate(); }
+    void paginated() { m_ring.paginated(); }
+
+    /**
+     * Whether to render neighbouring pages ahead (the default).  Off, every page is rendered
+     * when shown, as benchmarks want.
+     */
+    void setRenderAhead(bool renderAhead) { m_renderAhead = renderAhead; }
 
 protected:
+    friend class Renderer;
+    friend class PageRing;
+
+    /**
+     * Renders the page into fb rather than to the screen.
+     */
+    int renderTo(FrameBuffer *fb, unsigned int pageNum);
+
+    /**
+     * Wraps the string from strOffset, starting from the current pen position.
+     */
+    WrappedText *wrap(clc::Buffer *b, const uint8_t *breaks, unsigned int strOffset);
+
+    /**
+     * Draws the pending line, justified.
+     * @param lastOfParagraph  The line ends at a newline, so is not fully justified.
+     */
+    void flushLine(bool lastOfParagraph);
+
+    template<bool doBlit> void beginPage();
+    template<bool doBlit> void applyAttrs(int);
+    template<bool doBlit> int outputWrapped(clc::Buffer *b, const uint8_t *breaks, unsigned int strOffset);
+    template<bool doBlit> void endPage();
+
     FreeType *m_ft;
-    FrameBuffer *m_fb;
+    FreeType *m_ownFt;  ///< clones have their own m_ft
+    FrameBuffer *m_screen;
+    FrameBuffer *m_fb;  ///< being drawn to:  m_screen, or a page of m_ring
+    ShapedRuns m_runs;
+    LineCache m_lines;
+    unsigned int m_lineGeneration;  ///< FreeType::generation() of m_lines
+
+    /**
+     * Part of the line being drawn:  a box of one string, in one style.  A line may have any
+     * number of these, and is always drawn whole.
+     */
+    struct PendingRun {
+        const clc::Buffer *str;
+        const ShapedGlyph *run;
+        LineBox box;
+        int bold;
+        int em;
+        int justify;
+    };
+    std::vector<PendingRun> m_pending;
     int m_col;
     int m_penX;
     int m_penY;
     int m_lineHeight;
     int m_page;
-
-    void pushAttrs();
-    void applyAttrs(int i);
-    void popAttrs();
-
-    Attrs a[10];
-    int ai;
+    bool m_renderAhead;
+    PageRing m_ring;  ///< last, so that its worker stops first
 };
 
 #endif
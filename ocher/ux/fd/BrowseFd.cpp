@@ -5,8 +5,10 @@
 
 #include "ocher/device/Filesystem.h"
 #include "ocher/ux/fd/BrowseFd.h"
+#include "ocher/ux/Paginator.h"
 #include "ocher/ux/Renderer.h"
 #include "ocher/settings/Options.h"
+#include "ocher/settings/Settings.h"
 
 // TODO:  handle non-ttys
 
@@ -48,20 +50,22 @@ void BrowseFd::browse()
 
 }
 
-void BrowseFd::read(Renderer& renderer)
+void BrowseFd::read(Renderer& renderer, Paginator& paginator)
 {
-    for (int pageNum = 0; ; ) {
-        if (renderer.render(pageNum, true) < 0)
+    for (Place place; ; ) {
+        if (show(place, renderer, paginator) < 0)
             return;
+        if (settings.showPageNumbers) {
+            // On the row the renderer left free.
+            clc::Buffer status = pageStatus(place, renderer, paginator);
+            write(m_out, status.c_str(), status.size());
+        }
 
         char key = getKey();
         if (key == 'p' || key == 'b') {
-            if (pageNum > 0)
-                pageNum--;
-        } else if (key == 'q') {
+            back(place, renderer);
+        } else if (key == 'q' || ! forward(place, renderer)) {
             break;
-        } else {
-            pageNum++;
         }
     }
 }
@@ -11,7 +11,7 @@ public:
 
     bool init();
     void browse();
-    void read(Renderer& renderer);
+    void read(Renderer& renderer, Paginator& paginator);
 
 protected:
     int m_in;
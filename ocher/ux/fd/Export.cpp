@@ -0,0 +1,156 @@
+#include <sys/stat.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <algorithm>
+#include <list>
+#include <set>
+
+#include "clc/data/List.h"
+#include "clc/os/ThreadPool.h"
+#include "clc/storage/Path.h"
+#include "clc/support/Logger.h"
+
+#include "ocher/fmt/Layout.h"
+#include "ocher/ux/Controller.h"
+#include "ocher/ux/fd/Export.h"
+#include "ocher/ux/fd/RenderFd.h"
+
+
+Export::Export(bool ansi, const char *outDir) :
+    m_ansi(ansi),
+    m_outDir(outDir)
+{
+}
+
+static bool byName(const clc::Buffer &a, const clc::Buffer &b)
+{
+    return strcmp(a.c_str(), b.c_str()) < 0;
+}
+
+int Export::list(const char *dir, std::vector<clc::Buffer> &files)
+{
+    clc::List names;
+    int r = clc::Path::list(dir, 0, names);
+    std::vector<clc::Buffer> found;
+    for (unsigned int i = 0; i < names.size(); ++i) {
+        clc::Buffer *name = (clc::Buffer*)names.get(i);
+        clc::Buffer path(dir);
+        clc::Path::join(path, name->c_str());
+        struct stat s;
+        if (name->c_str()[0] != '.' && stat(path.c_str(), &s) == 0 && S_ISREG(s.st_mode))
+            found.push_back(path);
+        delete name;
+    }
+    std::sort(found.begin(), found.end(), byName);
+    files.insert(files.end(), found.begin(), found.end());
+    return r;
+}
+
+bool Export::exportBook(const char *file, int fd)
+{
+    Layout *layout = 0;
+    int r = -1;
+    try {
+        clc::Buffer memLayout;
+        std::list<EmbeddedFont> fonts;
+        layout = Controller::loadBook(file, memLayout, fonts);
+        RendererFd renderer(fd, width);
+        renderer.setAnsi(m_ansi);
+        renderer.set(memLayout);
+        r = renderer.stream();
+    } catch (...) {
+        clc::Log::error("ocher.export", "%s: failed to load", file);
+    }
+    delete layout;
+    return r == 1;
+}
+
+void Export::outputPaths(const std::vector<clc::Buffer> &files, std::vector<clc::Buffer> &paths)
+{
+    std::set<clc::Buffer> taken;
+    for (unsigned int i = 0; i < files.size(); ++i) {
+        clc::Buffer dir;
+        clc::Buffer name;
+        clc::Path::split(files[i].c_str(), dir, name);
+        clc::Buffer path(m_outDir);
+        clc::Path::join(path, name.c_str());
+        clc::Buffer unique(path);
+        unique += ".txt";
+        for (unsigned int n = 2; taken.find(unique) != taken.end(); ++n)
+            unique.format("%s-%u.txt", path.c_str(), n);
+        if (unique.size() != path.size() + 4)
+            clc::Log::info("ocher.export", "%s: exporting to %s", files[i].c_str(), unique.c_str());
+        taken.insert(unique);
+        paths.push_back(unique);
+    }
+}
+
+/**
+ * Exports a book per item, each to its own file.
+ */
+class ExportJob : public clc::ThreadPool::Job
+{
+public:
+    ExportJob(Export &exporter, const std::vector<clc::Buffer> &files,
+            const std::vector<clc::Buffer> &paths) :
+        m_exporter(exporter),
+        m_files(files),
+        m_paths(paths),
+        m_failed(0)
+    {
+    }
+
+    void run(unsigned int worker, unsigned int item)
+    {
+        (void)worker;
+        const char *file = m_files[item].c_str();
+        const clc::Buffer &path = m_paths[item];
+
+        bool ok = false;
+        int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0666);
+        if (fd < 0) {
+            clc::Log::error("ocher.export", "%s: %s", path.c_str(), strerror(errno));
+        } else {
+            ok = m_exporter.exportBook(file, fd);
+            if (::close(fd) != 0)
+                ok = false;
+        }
+        if (! ok) {
+            clc::Locker locker(m_lock);
+            ++m_failed;
+        }
+    }
+
+    unsigned int failed() const { return m_failed; }
+
+protected:
+    Export &m_exporter;
+    const std::vector<clc::Buffer> &m_files;
+    const std::vector<clc::Buffer> &m_paths;  ///< by item
+    clc::Lock m_lock;  ///< guards m_failed
+    unsigned int m_failed;
+};
+
+unsigned int Export::run(const std::vector<clc::Buffer> &files)
+{
+    if (m_outDir) {
+        // Decided up front, so that no two jobs write the same file.
+        std::vector<clc::Buffer> paths;
+        outputPaths(files, paths);
+        clc::ThreadPool pool;
+        ExportJob job(*this, files, paths);
+        pool.run(job, files.size());
+        return job.failed();
+    }
+
+    // In order, so one at a time.
+    unsigned int failed = 0;
+    for (unsigned int i = 0; i < files.size(); ++i) {
+        if (! exportBook(files[i].c_str(), STDOUT_FILENO))
+            ++failed;
+    }
+    return failed;
+}
@@ -0,0 +1,56 @@
+#ifndef OCHER_UX_FD_EXPORT_H
+#define OCHER_UX_FD_EXPORT_H
+
+#include <vector>
+
+#include "clc/data/Buffer.h"
+
+
+/**
+ * Streams whole books as text, plain or styled with ANSI escapes, for indexing and diffing:
+ * laid out and written by a RendererFd without pages, in large blocks, with no terminal
+ * involved.
+ *
+ * Books go to stdout one after another, or each to a file of its own in a directory, in which
+ * case they are exported in parallel (a book per clc::ThreadPool job).
+ */
+class Export
+{
+public:
+    /**
+     * @param outDir  Where to write each book, as its file name plus ".txt" (see outputPaths); 0
+     *      for stdout.
+     */
+    Export(bool ansi, const char *outDir);
+
+    /**
+     * Appends the books in the directory (its files not starting with '.'), sorted by name.
+     * @return 0 or errno
+     */
+    static int list(const char *dir, std::vector<clc::Buffer> &files);
+
+    /**
+     * @return The number of books that failed.
+     */
+    unsigned int run(const std::vector<clc::Buffer> &files);
+
+    /**
+     * Writes the book to fd.
+     * @return Whether it was exported whole.
+     */
+    bool exportBook(const char *file, int fd);
+
+protected:
+    /**
+     * Where to write each book in outDir:  its file name plus ".txt", numbered ("-2.txt", ...)
+     * where books share a name.
+     */
+    void outputPaths(const std::vector<clc::Buffer> &files, std::vector<clc::Buffer> &paths);
+
+    static const int width = 80;  ///< columns
+
+    bool m_ansi;
+    const char *m_outDir;
+};
+
+#endif
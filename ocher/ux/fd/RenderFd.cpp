@@ -1,5 +1,5 @@
-#define __USE_GNU  // for memrchr
 #include <sys/ioctl.h>
+#include <errno.h>
 #include <termios.h>
 #include <unistd.h>
 #include <stdint.h>
@@ -10,8 +10,9 @@
 #include "clc/support/Logger.h"
 
 #include "ocher/settings/Options.h"
+#include "ocher/settings/Settings.h"
+#include "ocher/ux/RenderLoop.h"
 #include "ocher/ux/fd/RenderFd.h"
-#include "ocher/fmt/Layout.h"
 
 
 // TODO:  margins (not the same as margins for fb?)
@@ -21,7 +22,11 @@ RendererFd::RendererFd() :
     m_x(0),
     m_y(0),
     m_page(1),
-    ai(1)
+    m_ul(false),
+    m_em(false),
+    m_ansi(true),
+    m_streaming(false),
+    m_failed(false)
 {
     struct winsize win;
     if (ioctl(0, TIOCGWINSZ, &win) != 0) {
@@ -33,9 +38,27 @@ RendererFd::RendererFd() :
     }
 }
 
+RendererFd::RendererFd(int fd, int width) :
+    m_fd(fd),
+    m_width(width),
+    m_height(0),
+    m_x(0),
+    m_y(0),
+    m_page(1),
+    m_ul(false),
+    m_em(false),
+    m_ansi(true),
+    m_streaming(false),
+    m_failed(false)
+{
+}
+
 bool RendererFd::init()
 {
     m_fd = opt.inFd;
+    // Leave the last row to the browser.
+    if (settings.showPageNumbers && m_height > 1)
+        --m_height;
     return true;
 }
 
@@ -44,59 +67,63 @@ void RendererFd::setWidth(int width)
     m_width = width;
 }
 
-void RendererFd::clearScreen()
-{
-    write(m_fd, "\033E", 2);
-}
-
-void RendererFd::enableUl()
-{
-    write(m_fd, "\x1b[4m", 5);
-}
-
-void RendererFd::disableUl()
+void RendererFd::layoutKey(clc::Buffer &key)
 {
-    write(m_fd, "\x1b[24m", 6);
+    key.appendFormat("fd %dx%d\n", m_width, m_height);
 }
 
-void RendererFd::enableEm()
-{
-    write(m_fd, "\x1b[1m", 5);
-}
-
-void RendererFd::disableEm()
+void RendererFd::clearScreen()
 {
-    write(m_fd, "\x1b[22m", 6);
+    output("\033E", 2);
 }
 
-void RendererFd::pushAttrs()
+void RendererFd::syncAttrs(bool ul, bool em)
 {
-    a[ai+1] = a[ai];
-    ai++;
+    if (! m_ansi)
+        return;
+    if (ul != m_ul) {
+        if (ul)
+            output("\x1b[4m", 4);
+        else
+            output("\x1b[24m", 5);
+        m_ul = ul;
+    }
+    if (em != m_em) {
+        if (em)
+            output("\x1b[1m", 4);
+        else
+            output("\x1b[22m", 5);
+        m_em = em;
+    }
 }
 
-void RendererFd::applyAttrs(int i)
+void RendererFd::flush()
 {
-    if (a[ai].ul && !a[ai-i].ul) {
-        enableUl();
-    } else if (!a[ai].ul && a[ai-i].ul) {
-        disableUl();
-    }
-
-    if (a[ai].em && !a[ai-i].em) {
-        enableEm();
-    } else if (!a[ai].em && a[ai-i].em) {
-        disableEm();
+    const char *p = m_out.empty() ? 0 : &m_out[0];
+    size_t n = m_out.size();
+    while (n > 0) {
+        ssize_t r = write(m_fd, p, n);
+        if (r < 0) {
+            if (errno == EINTR)
+                continue;
+            clc::Log::error("ocher.render", "write failed: %s", strerror(errno));
+            m_failed = true;
+            break;
+        }
+        p += r;
+        n -= r;
     }
+    m_out.clear();
 }
 
-void RendererFd::popAttrs()
+template<bool doBlit>
+void RendererFd::applyAttrs(int)
 {
-    ai--;
-    applyAttrs(-1);
+    // Nothing to do until text is output; see syncAttrs.
 }
 
-int RendererFd::outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doBlit)
+template<bool doBlit>
+int RendererFd::outputWrapped(clc::Buffer *b, const uint8_t *breaks, unsigned int strOffset)
 {
     int len = b->size();
     const unsigned char *start = (const unsigned char*)b->data();
@@ -119,6 +146,7 @@ int RendererFd::outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doBli
 
         // How many chars should go out on this line?
         const unsigned char *nl = 0;
+        bool wrap = false;
         int n = w;
         if (w >= len) {
             n = len;
@@ -127,32 +155,39 @@ int RendererFd::outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doBli
             nl = (const unsigned char *)memchr(p, '\n', n);
             if (!nl) {
                 // don't break words
-                if (!isspace(*(p+n-1)) && !isspace(*(p+n))) {
-                    unsigned char *space = (unsigned char*)memrchr(p, ' ', n);
-                    if (space) {
-                        nl = space;
-                    }
-                }
+                n = LineBreak::fit(start, b->size(), breaks, p - start, n, m_x > 0);
+                wrap = true;
             }
         }
         if (nl)
             n = nl - p;
 
-        if (doBlit)
-            write(m_fd, p, n);
+        // Trailing spaces hang past the margin; don't draw them.
+        int visible = n;
+        if (wrap) {
+            while (visible > 0 && p[visible-1] == ' ')
+                --visible;
+        }
+
+        if (doBlit && visible > 0) {
+            syncAttrs(a[ai].ul, a[ai].em);
+            output(p, visible);
+        }
         p += n;
         len -= n;
         m_x += n;
-        if (nl || m_x >= m_width-1) {
+        if (nl || wrap || m_x >= m_width-1) {
             if (doBlit)
-                write(m_fd, "\n", 1);
+                output("\n", 1);
             m_x = 0;
             m_y++;
             if (nl) {
                 p++;
                 len--;
             }
-            if (m_height > 0 && m_y >= m_height) {
+            if (doBlit && m_out.size() >= blockSize)
+                flush();
+            if ((m_height > 0 && m_y >= m_height) || (m_lineLimit && m_y >= (int)m_lineLimit)) {
                 return p - start;
             }
         }
@@ -160,132 +195,87 @@ int RendererFd::outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doBli
     return -1;
 }
 
-
-int RendererFd::render(unsigned int pageNum, bool doBlit)
+template<bool doBlit>
+void RendererFd::beginPage()
 {
     m_x = 0;
     m_y = 0;
-    if (m_height) {
+    if (doBlit && m_height) {
         clearScreen();
     }
+}
+
+template<bool doBlit>
+void RendererFd::endPage()
+{
+    if (!doBlit)
+        return;
+    // Leave the terminal plain.
+    syncAttrs(false, false);
+    if (! m_streaming)
+        flush();
+}
 
-    unsigned int layoutOffset;
-    unsigned int strOffset;
-    if (!pageNum) {
-        layoutOffset = 0;
-        strOffset = 0;
-    } else if (! m_pagination.get(pageNum-1, &layoutOffset, &strOffset)) {
-        // Previous page not already paginated?
-        // Perhaps at end of book?
-        return -1;
+int RendererFd::render(unsigned int pageNum, bool doBlit)
+{
+    clc::Locker locker(m_renderLock);
+    if (doBlit)
+        return renderPage<RendererFd, true>(pageNum);
+    else
+        return renderPage<RendererFd, false>(pageNum);
+}
+
+int RendererFd::stream()
+{
+    clc::Locker locker(m_renderLock);
+    m_streaming = true;
+    m_failed = false;
+    setAttrStack(Pagination::AttrStack());
+    unsigned int layoutOffset = 0;
+    unsigned int strOffset = 0;
+    int r = 0;
+    // Without a height, only forced page breaks (chapters) end pages.
+    while (r == 0 && ! m_failed && layoutOffset < m_layout.size()) {
+        r = renderFrom<RendererFd, true>(&layoutOffset, &strOffset);
+        if (m_x)
+            output("\n", 1);
     }
+    flush();
+    m_streaming = false;
+    return m_failed || r < 0 ? -1 : 1;
+}
 
-    const unsigned int N = m_layout.size();
-    const char *raw = m_layout.data();
-    ASSERT(layoutOffset < N);
-    for (unsigned int i = layoutOffset; i < N; ) {
-        ASSERT(i+2 <= N);
-        uint16_t code = *(uint16_t*)(raw+i);
-        i += 2;
+int RendererFd::renderAt(Pagination::Break *start)
+{
+    clc::Locker locker(m_renderLock);
+    return renderAtFrom<RendererFd>(start);
+}
 
-        unsigned int opType = (code>>12)&0xf;
-        unsigned int op = (code>>8)&0xf;
-        unsigned int arg = code & 0xff;
-        switch (opType) {
-            case Layout::OpPushTextAttr:
-                clc::Log::debug("ocher.renderer.fd", "OpPushTextAttr");
-                switch (op) {
-                    case Layout::AttrBold:
-                        pushAttrs();
-                        a[ai].b = 1;
-                        if (doBlit)
-                            applyAttrs(1);
-                        break;
-                    case Layout::AttrUnderline:
-                        pushAttrs();
-                        a[ai].ul = 1;
-                        if (doBlit)
-                            applyAttrs(1);
-                        break;
-                    case Layout::AttrItalics:
-                        pushAttrs();
-                        a[ai].em = 1;
-                        if (doBlit)
-                            applyAttrs(1);
-                        break;
-                    case Layout::AttrSizeRel:
-                        pushAttrs();
-                        break;
-                    case Layout::AttrSizeAbs:
-                        pushAttrs();
-                        break;
-                    default:
-                        clc::Log::error("ocher.renderer.fd", "unknown OpPushTextAttr");
-                        ASSERT(0);
-                        break;
-                }
-                break;
-            case Layout::OpPushLineAttr:
-                clc::Log::debug("ocher.renderer.fd", "OpPushLineAttr");
-                switch (op) {
-                    case Layout::LineJustifyLeft:
-                        break;
-                    case Layout::LineJustifyCenter:
-                        break;
-                    case Layout::LineJustifyFull:
-                        break;
-                    case Layout::LineJustifyRight:
-                        break;
-                    default:
-                        clc::Log::error("ocher.renderer.fd", "unknown OpPushLineAttr");
-                        ASSERT(0);
-                        break;
-                }
-                break;
-            case Layout::OpCmd:
-                switch (op) {
-                    case Layout::CmdPopAttr:
-                        clc::Log::debug("ocher.renderer.fd", "OpCmd CmdPopAttr");
-                        if (arg == 0)
-                            arg = 1;
-                        while (arg--)
-                            popAttrs();
-                        break;
-                    case Layout::CmdOutputStr: {
-                        clc::Log::debug("ocher.renderer.fd", "OpCmd CmdOutputStr");
-                        ASSERT(i + sizeof(clc::Buffer*) <= N);
-                        clc::Buffer *str = *(clc::Buffer**)(raw+i);
-                        ASSERT(strOffset <= str->size());
-                        int breakOffset = outputWrapped(str, strOffset, doBlit);
-                        strOffset = 0;
-                        if (breakOffset >= 0) {
-                            if (!doBlit) {
-                                m_pagination.set(pageNum, i-2, breakOffset);
-                            }
-                            return 0;
-                        }
-                        i += sizeof(clc::Buffer*);
-                        break;
-                    }
-                    case Layout::CmdForcePage:
-                        clc::Log::debug("ocher.renderer.fd", "OpCmd CmdForcePage");
-                        break;
-                    default:
-                        clc::Log::error("ocher.renderer.fd", "unknown OpCmd");
-                        ASSERT(0);
-                        break;
-                }
-                break;
-            case Layout::OpSpacing:
-                break;
-            case Layout::OpImage:
-                break;
-            default:
-                clc::Log::error("ocher.renderer.fd", "unknown op type");
-                ASSERT(0);
-                break;
+int RendererFd::measure(unsigned int *layoutOffset, unsigned int *strOffset)
+{
+    clc::Locker locker(m_renderLock);
+    return measureFrom<RendererFd>(layoutOffset, strOffset);
+}
 
-        };
-    }
-    return 1;
+Renderer *RendererFd::clone()
+{
+    clc::Locker locker(m_renderLock);
+    RendererFd *r = new RendererFd;
+    r->m_width = m_width;
+    r->m_height = m_height;
+    r->m_layout = m_layout;
+    return r;
+}
+
+int RendererFd::paginateChapter(unsigned int layoutOffset, unsigned int end,
+        std::vector<Pagination::Break> &breaks)
+{
+    clc::Locker locker(m_renderLock);
+    return paginateChapterFrom<RendererFd>(layoutOffset, end, breaks);
+}
+
+int RendererFd::pageBefore(Pagination::Break *start)
+{
+    clc::Locker locker(m_renderLock);
+    return pageBeforeFrom<RendererFd>(start);
 }
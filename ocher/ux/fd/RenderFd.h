@@ -1,21 +1,59 @@
 #ifndef OCHER_FD_RENDERER_H
 #define OCHER_FD_RENDERER_H
 
+#include <vector>
+
 #include "ocher/ux/Renderer.h"
 
 
+/**
+ * Renders to a terminal (or any fd) as plain text, with ANSI escapes for underline and bold.
+ * Each page is composed in memory and written with a single write, as every syscall counts
+ * over a serial console or a slow ssh session.  Escapes are only emitted where the attributes
+ * in effect for the text change.
+ */
 class RendererFd : public Renderer
 {
 public:
+    /**
+     * Renders to the terminal, sized as it is.
+     */
     RendererFd();
+    /**
+     * Renders without pages (and without querying a terminal), for stream.
+     */
+    RendererFd(int fd, int width);
 
     bool init();
     int render(unsigned int pageNum, bool doBlit);
+    int renderAt(Pagination::Break *start);
+    int measure(unsigned int *layoutOffset, unsigned int *strOffset);
+    Renderer *clone();
+    int paginateChapter(unsigned int layoutOffset, unsigned int end,
+            std::vector<Pagination::Break> &breaks);
+    int pageBefore(Pagination::Break *start);
+    void layoutKey(clc::Buffer &key);
 
     void setWidth(int width);
-    int outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doBlit);
+    /**
+     * Whether to style text with ANSI escapes (the default), or to output plain text.
+     */
+    void setAnsi(bool ansi) { m_ansi = ansi; }
+
+    /**
+     * Writes the whole book, in large blocks, without pagination.
+     * @return 1, or -1 on failure
+     */
+    int stream();
 
 protected:
+    friend class Renderer;
+
+    template<bool doBlit> void beginPage();
+    template<bool doBlit> void applyAttrs(int i);
+    template<bool doBlit> int outputWrapped(clc::Buffer *b, const uint8_t *breaks, unsigned int strOffset);
+    template<bool doBlit> void endPage();
+
     int m_fd;
     int m_width;
     int m_height;
@@ -23,18 +61,24 @@ protected:
     int m_y;
     int m_page;
 
-    void clearScreen();
-    void enableUl();
-    void disableUl();
-    void enableEm();
-    void disableEm();
-
-    void pushAttrs();
-    void applyAttrs(int i);
-    void popAttrs();
+    static const size_t blockSize = 64*1024;  ///< flushed at, if a page is longer
+    std::vector<char> m_out;  ///< the page being composed
+    bool m_ul;  ///< as in m_out so far
+    bool m_em;
+    bool m_ansi;
+    bool m_streaming;  ///< pages (without a height, chapters) are not flushed whole
+    bool m_failed;  ///< to write
 
-    Attrs a[10];
-    int ai;
+    void output(const void *p, size_t n) { m_out.insert(m_out.end(), (const char*)p, (const char*)p + n); }
+    /**
+     * Emits the escapes that bring the terminal to the attributes in effect, before text.
+     */
+    void syncAttrs(bool ul, bool em);
+    /**
+     * Writes the page composed in m_out.
+     */
+    void flush();
+    void clearScreen();
 };
 
 #endif
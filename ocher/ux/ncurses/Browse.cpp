@@ -1,16 +1,21 @@
+#include "clc/data/Buffer.h"
 #include "clc/tui/Tui.h"
 
+#include "ocher/settings/Settings.h"
+#include "ocher/ux/Paginator.h"
 #include "ocher/ux/Renderer.h"
 #include "ocher/ux/ncurses/Browse.h"
 
 
-BrowseCurses::BrowseCurses()
+BrowseCurses::BrowseCurses() :
+    m_status(0)
 {
 }
 
 bool BrowseCurses::init(clc::Tui* tui)
 {
     m_tui = tui;
+    m_status = new clc::Window(tui->mainWindow());
     return true;
 }
 
@@ -21,21 +26,27 @@ void BrowseCurses::browse()
     //}
 }
 
-void BrowseCurses::read(Renderer& renderer)
+void BrowseCurses::read(Renderer& renderer, Paginator& paginator)
 {
-    for (int pageNum = 0; ; ) {
-        if (renderer.render(pageNum, true) < 0)
+    for (Place place; ; ) {
+        if (show(place, renderer, paginator) < 0)
             return;
+        if (settings.showPageNumbers) {
+            // On the row the renderer left free.
+            int width, height;
+            m_status->getMaxXY(width, height);
+            clc::Buffer status = pageStatus(place, renderer, paginator);
+            m_status->mvAddNStr(0, height-1, status.c_str(), status.size());
+            m_status->clearToEol();
+            m_status->refresh();
+        }
 
         clc::Keystroke::Modifiers m;
         clc::Keystroke key = clc::Tui::getKey(&m);
         if (key == 'p' || key == 'b') {
-            if (pageNum > 0)
-                pageNum--;
-        } else if (key == 'q') {
+            back(place, renderer);
+        } else if (key == 'q' || ! forward(place, renderer)) {
             break;
-        } else {
-            pageNum++;
         }
     }
 }
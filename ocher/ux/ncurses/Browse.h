@@ -11,14 +11,15 @@ class BrowseCurses : public Browse
 {
 public:
     BrowseCurses();
-    ~BrowseCurses() {}
+    ~BrowseCurses() { delete m_status; }
 
     bool init(clc::Tui* tui);
     void browse();
-    void read(Renderer& renderer);
+    void read(Renderer& renderer, Paginator& paginator);
 
 protected:
     clc::Tui* m_tui;
+    clc::Window* m_status;
 };
 
 
@@ -1,4 +1,3 @@
-#define __USE_GNU  // for memrchr
 #include <unistd.h>
 #include <stdint.h>
 #include <ctype.h>
@@ -8,8 +7,9 @@
 #include "clc/support/Logger.h"
 
 #include "ocher/settings/Options.h"
+#include "ocher/settings/Settings.h"
+#include "ocher/ux/RenderLoop.h"
 #include "ocher/ux/ncurses/RenderCurses.h"
-#include "ocher/fmt/Layout.h"
 
 
 // TODO:  page size
@@ -18,8 +18,7 @@
 RenderCurses::RenderCurses() :
     m_x(0),
     m_y(0),
-    m_page(1),
-    ai(1)
+    m_page(1)
 {
 }
 
@@ -27,9 +26,17 @@ bool RenderCurses::init(clc::Tui* tui)
 {
     m_window = new clc::Window(tui->mainWindow());
     m_window->getMaxXY(m_width, m_height);
+    // Leave the last row to the browser.
+    if (settings.showPageNumbers && m_height > 1)
+        --m_height;
     return true;
 }
 
+void RenderCurses::layoutKey(clc::Buffer &key)
+{
+    key.appendFormat("curses %dx%d\n", m_width, m_height);
+}
+
 void RenderCurses::enableUl()
 {
 }
@@ -46,14 +53,12 @@ void RenderCurses::disableEm()
 {
 }
 
-void RenderCurses::pushAttrs()
-{
-    a[ai+1] = a[ai];
-    ai++;
-}
-
+template<bool doBlit>
 void RenderCurses::applyAttrs(int i)
 {
+    if (!doBlit)
+        return;
+
     if (a[ai].ul && !a[ai-i].ul) {
         enableUl();
     } else if (!a[ai].ul && a[ai-i].ul) {
@@ -67,13 +72,8 @@ void RenderCurses::applyAttrs(int i)
     }
 }
 
-void RenderCurses::popAttrs()
-{
-    ai--;
-    applyAttrs(-1);
-}
-
-int RenderCurses::outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doBlit)
+template<bool doBlit>
+int RenderCurses::outputWrapped(clc::Buffer *b, const uint8_t *breaks, unsigned int strOffset)
 {
     int len = b->size();
     const unsigned char *start = (const unsigned char*)b->data();
@@ -96,6 +96,7 @@ int RenderCurses::outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doB
 
         // How many chars should go out on this line?
         const unsigned char *nl = 0;
+        bool wrap = false;
         int n = w;
         if (w >= len) {
             n = len;
@@ -104,31 +105,34 @@ int RenderCurses::outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doB
             nl = (const unsigned char *)memchr(p, '\n', n);
             if (!nl) {
                 // don't break words
-                if (!isspace(*(p+n-1)) && !isspace(*(p+n))) {
-                    unsigned char *space = (unsigned char*)memrchr(p, ' ', n);
-                    if (space) {
-                        nl = space;
-                    }
-                }
+                n = LineBreak::fit(start, b->size(), breaks, p - start, n, m_x > 0);
+                wrap = true;
             }
         }
         if (nl)
             n = nl - p;
 
+        // Trailing spaces hang past the margin; don't draw them.
+        int visible = n;
+        if (wrap) {
+            while (visible > 0 && p[visible-1] == ' ')
+                --visible;
+        }
+
         if (doBlit) {
-            m_window->mvAddNStr(m_x, m_y, (const char*)p, n);
+            m_window->mvAddNStr(m_x, m_y, (const char*)p, visible);
         }
         p += n;
         len -= n;
         m_x += n;
-        if (nl || m_x >= m_width-1) {
+        if (nl || wrap || m_x >= m_width-1) {
             m_x = 0;
             m_y++;
             if (nl) {
                 p++;
                 len--;
             }
-            if (m_height > 0 && m_y >= m_height) {
+            if ((m_height > 0 && m_y >= m_height) || (m_lineLimit && m_y >= (int)m_lineLimit)) {
                 return p - start;
             }
         }
@@ -136,135 +140,64 @@ int RenderCurses::outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doB
     return -1;
 }
 
-
-int RenderCurses::render(unsigned int pageNum, bool doBlit)
+template<bool doBlit>
+void RenderCurses::beginPage()
 {
     m_x = 0;
     m_y = 0;
-    if (m_height) {
+    if (doBlit && m_height) {
         m_window->clear();
     }
+}
 
-    unsigned int layoutOffset;
-    unsigned int strOffset;
-    if (!pageNum) {
-        layoutOffset = 0;
-        strOffset = 0;
-    } else if (! m_pagination.get(pageNum-1, &layoutOffset, &strOffset)) {
-        // Previous page not already paginated?
-        // Perhaps at end of book?
-        return -1;
-    }
+template<bool doBlit>
+void RenderCurses::endPage()
+{
+    if (doBlit)
+        m_window->refresh();
+}
 
-    const unsigned int N = m_layout.size();
-    const char *raw = m_layout.data();
-    ASSERT(layoutOffset < N);
-    for (unsigned int i = layoutOffset; i < N; ) {
-        ASSERT(i+2 <= N);
-        uint16_t code = *(uint16_t*)(raw+i);
-        i += 2;
+int RenderCurses::render(unsigned int pageNum, bool doBlit)
+{
+    clc::Locker locker(m_renderLock);
+    if (doBlit)
+        return renderPage<RenderCurses, true>(pageNum);
+    else
+        return renderPage<RenderCurses, false>(pageNum);
+}
 
-        unsigned int opType = (code>>12)&0xf;
-        unsigned int op = (code>>8)&0xf;
-        unsigned int arg = code & 0xff;
-        switch (opType) {
-            case Layout::OpPushTextAttr:
-                clc::Log::debug("ocher.renderer.fd", "OpPushTextAttr");
-                switch (op) {
-                    case Layout::AttrBold:
-                        pushAttrs();
-                        a[ai].b = 1;
-                        if (doBlit)
-                            applyAttrs(1);
-                        break;
-                    case Layout::AttrUnderline:
-                        pushAttrs();
-                        a[ai].ul = 1;
-                        if (doBlit)
-                            applyAttrs(1);
-                        break;
-                    case Layout::AttrItalics:
-                        pushAttrs();
-                        a[ai].em = 1;
-                        if (doBlit)
-                            applyAttrs(1);
-                        break;
-                    case Layout::AttrSizeRel:
-                        pushAttrs();
-                        break;
-                    case Layout::AttrSizeAbs:
-                        pushAttrs();
-                        break;
-                    default:
-                        clc::Log::error("ocher.renderer.fd", "unknown OpPushTextAttr");
-                        ASSERT(0);
-                        break;
-                }
-                break;
-            case Layout::OpPushLineAttr:
-                clc::Log::debug("ocher.renderer.fd", "OpPushLineAttr");
-                switch (op) {
-                    case Layout::LineJustifyLeft:
-                        break;
-                    case Layout::LineJustifyCenter:
-                        break;
-                    case Layout::LineJustifyFull:
-                        break;
-                    case Layout::LineJustifyRight:
-                        break;
-                    default:
-                        clc::Log::error("ocher.renderer.fd", "unknown OpPushLineAttr");
-                        ASSERT(0);
-                        break;
-                }
-                break;
-            case Layout::OpCmd:
-                switch (op) {
-                    case Layout::CmdPopAttr:
-                        clc::Log::debug("ocher.renderer.fd", "OpCmd CmdPopAttr");
-                        if (arg == 0)
-                            arg = 1;
-                        while (arg--)
-                            popAttrs();
-                        break;
-                    case Layout::CmdOutputStr: {
-                        clc::Log::debug("ocher.renderer.fd", "OpCmd CmdOutputStr");
-                        ASSERT(i + sizeof(clc::Buffer*) <= N);
-                        clc::Buffer *str = *(clc::Buffer**)(raw+i);
-                        ASSERT(strOffset <= str->size());
-                        int breakOffset = outputWrapped(str, strOffset, doBlit);
-                        strOffset = 0;
-                        if (breakOffset >= 0) {
-                            if (!doBlit) {
-                                m_pagination.set(pageNum, i-2, breakOffset);
-                            } else {
-                                m_window->refresh();
-                            }
-                            return 0;
-                        }
-                        i += sizeof(clc::Buffer*);
-                        break;
-                    }
-                    case Layout::CmdForcePage:
-                        clc::Log::debug("ocher.renderer.fd", "OpCmd CmdForcePage");
-                        break;
-                    default:
-                        clc::Log::error("ocher.renderer.fd", "unknown OpCmd");
-                        ASSERT(0);
-                        break;
-                }
-                break;
-            case Layout::OpSpacing:
-                break;
-            case Layout::OpImage:
-                break;
-            default:
-                clc::Log::error("ocher.renderer.fd", "unknown op type");
-                ASSERT(0);
-                break;
+int RenderCurses::renderAt(Pagination::Break *start)
+{
+    clc::Locker locker(m_renderLock);
+    return renderAtFrom<RenderCurses>(start);
+}
 
-        };
-    }
-    m_window->refresh();
-    return 1;
+int RenderCurses::measure(unsigned int *layoutOffset, unsigned int *strOffset)
+{
+    clc::Locker locker(m_renderLock);
+    return measureFrom<RenderCurses>(layoutOffset, strOffset);
+}
+
+Renderer *RenderCurses::clone()
+{
+    clc::Locker locker(m_renderLock);
+    RenderCurses *r = new RenderCurses;
+    r->m_window = 0;  // only measures
+    r->m_width = m_width;
+    r->m_height = m_height;
+    r->m_layout = m_layout;
+    return r;
+}
+
+int RenderCurses::paginateChapter(unsigned int layoutOffset, unsigned int end,
+        std::vector<Pagination::Break> &breaks)
+{
+    clc::Locker locker(m_renderLock);
+    return paginateChapterFrom<RenderCurses>(layoutOffset, end, breaks);
+}
+
+int RenderCurses::pageBefore(Pagination::Break *start)
+{
+    clc::Locker locker(m_renderLock);
+    return pageBeforeFrom<RenderCurses>(start);
 }
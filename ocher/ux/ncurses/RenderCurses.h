@@ -13,10 +13,22 @@ public:
 
     bool init(clc::Tui* tui);
     int render(unsigned int pageNum, bool doBlit);
-
-    int outputWrapped(clc::Buffer *b, unsigned int strOffset, bool doBlit);
+    int renderAt(Pagination::Break *start);
+    int measure(unsigned int *layoutOffset, unsigned int *strOffset);
+    Renderer *clone();
+    int paginateChapter(unsigned int layoutOffset, unsigned int end,
+            std::vector<Pagination::Break> &breaks);
+    int pageBefore(Pagination::Break *start);
+    void layoutKey(clc::Buffer &key);
 
 protected:
+    friend class Renderer;
+
+    template<bool doBlit> void beginPage();
+    template<bool doBlit> void applyAttrs(int i);
+    template<bool doBlit> int outputWrapped(clc::Buffer *b, const uint8_t *breaks, unsigned int strOffset);
+    template<bool doBlit> void endPage();
+
     clc::Window* m_window;
     int m_width;
     int m_height;
@@ -28,13 +40,6 @@ protected:
     void disableUl();
     void enableEm();
     void disableEm();
-
-    void pushAttrs();
-    void applyAttrs(int i);
-    void popAttrs();
-
-    Attrs a[10];
-    int ai;
 };
 
 #endif